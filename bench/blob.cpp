@@ -0,0 +1,54 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "benchmarks.hpp"
+#include "libgit2++/detail/scope.hpp"
+#include "libgit2++/repository.hpp"
+#include "util.hpp"
+#include <git2/blob.h>
+
+
+void blob_benchmarks(const fixture & fxt) {
+	if(fxt.commit_ids.empty())
+		return;
+
+	auto repo      = git2pp::repository::open(fxt.path);
+	const auto id  = repo.commit_lookup(fxt.commit_ids.front()).tree().at_path(fxt.hot_path).id();
+	auto hot       = repo.blob_lookup(id);
+
+	git_repository * raw;
+	git_blob * raw_hot;
+	git_repository_open(&raw, fxt.path.c_str());
+	git_blob_lookup(&raw_hot, raw, &id);
+	git2pp::detail::quickscope_wrapper raw_cleanup{[&]() {
+		git_blob_free(raw_hot);
+		git_repository_free(raw);
+	}};
+
+	measure("blob::filtered", "libgit2++", 100000, [&](auto) { hot.filtered(fxt.hot_path); });
+	measure("blob::filtered", "libgit2", 100000, [&](auto) {
+		git_buf buf{};
+		git_blob_filtered_content(&buf, raw_hot, fxt.hot_path.c_str(), true);
+		git_buf_free(&buf);
+	});
+}
@@ -0,0 +1,60 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "benchmarks.hpp"
+#include "libgit2++/commit_graph.hpp"
+#include "libgit2++/detail/scope.hpp"
+#include "libgit2++/file_history.hpp"
+#include "libgit2++/repository.hpp"
+#include "util.hpp"
+#include <git2/graph.h>
+
+
+void commit_graph_benchmarks(const fixture & fxt) {
+	if(fxt.commit_ids.empty())
+		return;
+
+	auto repo        = git2pp::repository::open(fxt.path);
+	const auto path  = fxt.path + "/objects/info/commit-graph";
+	const auto & ids = fxt.commit_ids;
+	measure("commit_graph::write", "libgit2++", 1, [&](auto) { git2pp::commit_graph::write(repo, {ids.front()}, path); });
+
+	git_repository * raw;
+	git_repository_open(&raw, fxt.path.c_str());
+	git2pp::detail::quickscope_wrapper raw_cleanup{[&]() { git_repository_free(raw); }};
+
+	// Oldest commit against the newest one walks the whole history
+	const git2pp::commit_graph graph(path);
+	measure("commit_graph::is_ancestor", "libgit2++", 20, [&](auto) { graph.is_ancestor(ids.back(), ids.front()); });
+	measure("commit_graph::is_ancestor", "libgit2", 20, [&](auto) { git_graph_descendant_of(raw, &ids.front(), &ids.back()); });
+
+	measure("commit_graph::write", "changed paths", 1, [&](auto) { git2pp::commit_graph::write(repo, {ids.front()}, path, 0, true); });
+	const git2pp::commit_graph filtered(path);
+	const auto history = [&](const git2pp::commit_graph * with) {
+		git2pp::file_history hist(repo, ids.front(), fxt.hot_path, false, with);
+		for(auto && id : hist)
+			static_cast<void>(id);
+	};
+	measure("file_history", "changed paths", 3, [&](auto) { history(&filtered); });
+	measure("file_history", "object database", 3, [&](auto) { history(nullptr); });
+}
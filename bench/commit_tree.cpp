@@ -0,0 +1,73 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "benchmarks.hpp"
+#include "libgit2++/detail/scope.hpp"
+#include "libgit2++/repository.hpp"
+#include "util.hpp"
+#include <git2/commit.h>
+#include <git2/tree.h>
+
+
+void commit_tree_benchmarks(const fixture & fxt) {
+	if(fxt.commit_ids.empty())
+		return;
+
+	auto repo       = git2pp::repository::open(fxt.path);
+	const auto tree = repo.commit_lookup(fxt.commit_ids.front()).tree();
+
+	git_repository * raw;
+	git_commit * raw_commit;
+	git_tree * raw_tree;
+	git_repository_open(&raw, fxt.path.c_str());
+	git_commit_lookup(&raw_commit, raw, &fxt.commit_ids.front());
+	git_commit_tree(&raw_tree, raw_commit);
+	git2pp::detail::quickscope_wrapper raw_cleanup{[&]() {
+		git_tree_free(raw_tree);
+		git_commit_free(raw_commit);
+		git_repository_free(raw);
+	}};
+
+	std::size_t entries{};
+	measure("commit_tree::walk", "libgit2++", 20, [&](auto) {
+		tree.walk(git2pp::tree_walk_mode::pre, [&](const char *, const git2pp::commit_tree_entry &) {
+			++entries;
+			return 0;
+		});
+	});
+	measure("commit_tree::walk", "libgit2", 20, [&](auto) {
+		git_tree_walk(raw_tree, GIT_TREEWALK_PRE,
+		              [](const char *, const git_tree_entry *, void * payload) {
+			              ++*static_cast<std::size_t *>(payload);
+			              return 0;
+			            },
+		              &entries);
+	});
+
+	measure("commit_tree::at_path", "libgit2++", 100000, [&](auto) { tree.at_path(fxt.deep_path); });
+	measure("commit_tree::at_path", "libgit2", 100000, [&](auto) {
+		git_tree_entry * ent;
+		git_tree_entry_bypath(&ent, raw_tree, fxt.deep_path.c_str());
+		git_tree_entry_free(ent);
+	});
+}
@@ -0,0 +1,54 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "benchmarks.hpp"
+#include "libgit2++/detail/scope.hpp"
+#include "libgit2++/repository.hpp"
+#include "util.hpp"
+#include <git2/config.h>
+
+
+void configuration_benchmarks(const fixture & fxt) {
+	auto repo         = git2pp::repository::open(fxt.path);
+	const auto config = repo.config();
+
+	git_repository * raw;
+	git_config * raw_config;
+	git_repository_open(&raw, fxt.path.c_str());
+	git_repository_config(&raw_config, raw);
+	git2pp::detail::quickscope_wrapper raw_cleanup{[&]() {
+		git_config_free(raw_config);
+		git_repository_free(raw);
+	}};
+
+	measure("configuration::multivar", "libgit2++", 1000, [&](auto) { config.multivar("bench.multi"); });
+	measure("configuration::multivar", "libgit2", 1000, [&](auto) {
+		std::size_t values{};
+		git_config_get_multivar_foreach(raw_config, "bench.multi", nullptr,
+		                                [](const git_config_entry *, void * payload) {
+			                                ++*static_cast<std::size_t *>(payload);
+			                                return 0;
+			                              },
+		                                &values);
+	});
+}
@@ -0,0 +1,76 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "benchmarks.hpp"
+#include "libgit2++/fast_import.hpp"
+#include "libgit2++/repository.hpp"
+#include "util.hpp"
+#include <algorithm>
+#include <string>
+
+
+// Each commit changes one file of a few hundred in a subdirectory, the shape of most converted histories
+void fast_import_benchmarks(const fixture & fxt) {
+	const auto commits = std::min<std::size_t>(fxt.parameters.commits, 10000);
+	const std::size_t files = 500;
+	char name[]             = "Author";
+	char email[]            = "author@bench.localhost";
+	const auto file         = [&](std::size_t i) { return "src/file" + std::to_string(i % files) + ".txt"; };
+	const auto content      = [&](std::size_t i) { return "contents of " + file(i) + " at commit " + std::to_string(i) + '\n'; };
+
+	const auto dir = bench_directory("fast_import");
+	measure("fast_import", "fast_import", 1, [&](auto) {
+		remove_directory(dir.c_str());
+		auto repo = git2pp::repository::init(dir, true);
+
+		git2pp::fast_import import(repo);
+		for(std::size_t i = 0; i < commits; ++i) {
+			const git_signature sig{name, email, {static_cast<git_time_t>(1000000000 + i * 60), 0}};
+			import.file_modify(file(i), import.blob(content(i)));
+			import.commit("refs/heads/master", sig, sig, "Commit " + std::to_string(i) + '\n');
+		}
+		import.finish();
+	});
+
+	measure("fast_import", "commit_create", 1, [&](auto) {
+		remove_directory(dir.c_str());
+		auto repo = git2pp::repository::init(dir, true);
+
+		git2pp::commit_tree_builder sub_bld(repo);
+		git_oid head{};
+		for(std::size_t i = 0; i < commits; ++i) {
+			const git_signature sig{name, email, {static_cast<git_time_t>(1000000000 + i * 60), 0}};
+			sub_bld.insert(file(i).substr(4), repo.blob_create_from_buffer(content(i)), git2pp::filemode::blob);
+			git2pp::commit_tree_builder root_bld(repo);
+			root_bld.insert("src", sub_bld.write(), git2pp::filemode::tree);
+			const auto tree = repo.tree_lookup(root_bld.write());
+
+			if(!i)
+				head = repo.commit_create(sig, sig, "Commit " + std::to_string(i) + '\n', tree, std::vector<const git2pp::commit *>{}, "refs/heads/master");
+			else {
+				const auto parent = repo.commit_lookup(head);
+				head              = repo.commit_create(sig, sig, "Commit " + std::to_string(i) + '\n', tree, {&parent}, "refs/heads/master");
+			}
+		}
+	});
+}
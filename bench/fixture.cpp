@@ -0,0 +1,181 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "fixture.hpp"
+#include "libgit2++/repository.hpp"
+#include "util.hpp"
+#include <cstdio>
+#include <fstream>
+#include <git2/revwalk.h>
+#include <random>
+#include <sstream>
+
+
+using namespace std::literals;
+
+
+static std::string parameters_line(const fixture_parameters & parameters) {
+	std::ostringstream out;
+	out << parameters.commits << ' ' << parameters.refs << ' ' << parameters.width << ' ' << parameters.depth << ' ' << parameters.multivars;
+	return out.str();
+}
+
+static std::string join_lines(const std::vector<std::string> & lines) {
+	std::string result;
+	for(auto && line : lines)
+		result += line + '\n';
+	return result;
+}
+
+static std::string wide_name(std::size_t idx) {
+	char buf[16];
+	std::snprintf(buf, sizeof buf, "f%06zu", idx);
+	return buf;
+}
+
+// Level 0 is the "deep" directory itself, the leaf blob lives in the last level
+static git_oid build_deep(git2pp::repository & repo, std::size_t depth, const git_oid & level_blob, const git_oid & leaf_blob) {
+	git_oid below{};
+	for(auto level = depth; level-- > 0;) {
+		git2pp::commit_tree_builder bld(repo);
+		if(level + 1 == depth)
+			bld.insert("file", leaf_blob, git2pp::filemode::blob);
+		else {
+			bld.insert("file", level_blob, git2pp::filemode::blob);
+			bld.insert("l" + std::to_string(level + 1), below, git2pp::filemode::tree);
+		}
+		below = bld.write();
+	}
+	return below;
+}
+
+static void generate(const fixture & fxt) {
+	const auto & params = fxt.parameters;
+	std::fprintf(stderr, "generating %s (%s)\n", fxt.path.c_str(), parameters_line(params).c_str());
+
+	remove_directory(fxt.path.c_str());
+	auto repo = git2pp::repository::init(fxt.path, true);
+	std::mt19937 rng(42);
+
+
+	git2pp::commit_tree_builder wide_bld(repo);
+	for(std::size_t i = 0; i < params.width; ++i)
+		wide_bld.insert(wide_name(i), repo.blob_create_from_buffer("wide file " + std::to_string(i) + '\n'), git2pp::filemode::blob);
+	auto wide = wide_bld.write();
+
+	const auto level_blob = repo.blob_create_from_buffer("level file\n"s);
+	auto deep             = build_deep(repo, params.depth, level_blob, level_blob);
+
+	std::vector<std::string> hot_lines(200);
+	for(std::size_t i = 0; i < hot_lines.size(); ++i)
+		hot_lines[i] = "hot line " + std::to_string(i);
+	auto hot = repo.blob_create_from_buffer(join_lines(hot_lines));
+
+
+	std::vector<git_oid> commits;
+	commits.reserve(params.commits);
+	for(std::size_t i = 0; i < params.commits; ++i) {
+		switch(i % 3) {
+			case 0:
+				hot_lines[rng() % hot_lines.size()] = "hot line from commit " + std::to_string(i);
+				hot                                  = repo.blob_create_from_buffer(join_lines(hot_lines));
+				break;
+			case 1: {
+				git2pp::commit_tree_builder bld(repo, repo.tree_lookup(wide));
+				const auto idx = rng() % params.width;
+				bld.insert(wide_name(idx), repo.blob_create_from_buffer("wide file " + std::to_string(idx) + " from commit " + std::to_string(i) + '\n'),
+				           git2pp::filemode::blob);
+				wide = bld.write();
+			} break;
+			case 2:
+				deep = build_deep(repo, params.depth, level_blob, repo.blob_create_from_buffer("deep file from commit " + std::to_string(i) + '\n'));
+				break;
+		}
+
+		git2pp::commit_tree_builder root_bld(repo);
+		root_bld.insert("deep", deep, git2pp::filemode::tree);
+		root_bld.insert("hot.txt", hot, git2pp::filemode::blob);
+		root_bld.insert("wide", wide, git2pp::filemode::tree);
+		const auto tree = repo.tree_lookup(root_bld.write());
+
+		auto name  = "Author " + std::to_string(rng() % 50);
+		auto email = "author" + std::to_string(rng() % 50) + "@bench.localhost";
+		const git_signature sig{&name[0], &email[0], {static_cast<git_time_t>(1000000000 + i * 60), 0}};
+		const auto message = "Commit " + std::to_string(i) + '\n';
+
+		if(commits.empty())
+			commits.emplace_back(repo.commit_create(sig, sig, message, tree, std::vector<const git2pp::commit *>{}));
+		else {
+			const auto parent = repo.commit_lookup(commits.back());
+			commits.emplace_back(repo.commit_create(sig, sig, message, tree, {&parent}));
+		}
+
+		if((i + 1) % 10000 == 0)
+			std::fprintf(stderr, "  %zu/%zu commits\n", i + 1, params.commits);
+	}
+	if(!commits.empty())
+		repo.make_reference("refs/heads/master", commits.back(), "libgit2++ bench", true);
+
+
+	for(std::size_t i = 0; i < params.refs && !commits.empty(); ++i) {
+		char name[64];
+		std::snprintf(name, sizeof name, "refs/heads/bench/%06zu", i);
+		repo.make_reference(name, commits[rng() % commits.size()], "libgit2++ bench", true);
+	}
+
+	auto config = repo.config();
+	for(std::size_t i = 0; i < params.multivars; ++i)
+		config.multivar("bench.multi"s, "value " + std::to_string(i), "$^"s);
+
+	std::ofstream(repo.path() + "info/attributes") << "*.txt eol=crlf\n";
+	std::ofstream(repo.path() + "libgit2pp-bench") << parameters_line(params) << '\n';
+}
+
+
+fixture make_fixture(const fixture_parameters & parameters) {
+	fixture fxt{parameters, bench_directory("synthetic") + '/', "deep", "hot.txt", {}};
+	for(std::size_t level = 1; level < parameters.depth; ++level)
+		fxt.deep_path += "/l" + std::to_string(level);
+	fxt.deep_path += "/file";
+
+	std::string existing;
+	std::getline(std::ifstream(fxt.path + "libgit2pp-bench"), existing);
+	if(existing != parameters_line(parameters))
+		generate(fxt);
+
+
+	git_repository * repo;
+	git_revwalk * walk;
+	git_repository_open(&repo, fxt.path.c_str());
+	git_revwalk_new(&walk, repo);
+	git_revwalk_push_head(walk);
+
+	fxt.commit_ids.reserve(parameters.commits);
+	for(git_oid id; !git_revwalk_next(&id, walk);)
+		fxt.commit_ids.emplace_back(id);
+
+	git_revwalk_free(walk);
+	git_repository_free(repo);
+
+	return fxt;
+}
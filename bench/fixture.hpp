@@ -0,0 +1,54 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <git2/oid.h>
+#include <string>
+#include <vector>
+
+
+struct fixture_parameters {
+	std::size_t commits   = 100000;
+	std::size_t refs      = 50000;
+	std::size_t width     = 10000;
+	std::size_t depth     = 64;
+	std::size_t multivars = 1000;
+};
+
+struct fixture {
+	fixture_parameters parameters;
+
+	std::string path;
+	std::string deep_path;
+	std::string hot_path;
+
+	// Newest first
+	std::vector<git_oid> commit_ids;
+};
+
+
+// Reuses the repository from an earlier run if it was generated with the same parameters
+fixture make_fixture(const fixture_parameters & parameters);
@@ -0,0 +1,74 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "benchmarks.hpp"
+#include "libgit2++/guard.hpp"
+#include "libgit2++/repository.hpp"
+#include "libgit2++/signature.hpp"
+#include "util.hpp"
+#include <string>
+#include <vector>
+
+
+using namespace std::literals;
+
+
+void guard_benchmarks() {
+	// Nothing else holds libgit2, so every guard goes through the global 0<->1 transition
+	measure("guard", "cold", 10000, [](auto) { git2pp::guard grd; });
+
+	{
+		git2pp::guard outer;
+		measure("guard", "guard", 10000000, [](auto) { git2pp::guard grd; });
+	}
+	{
+		git2pp::runtime rt;
+		measure("guard", "runtime", 10000000, [](auto) { git2pp::guard grd; });
+	}
+
+
+	const git_signature sig{const_cast<char *>("libgit2++ bench"), const_cast<char *>("bench@localhost"), {0, 0}};
+	{
+		git2pp::guard outer;
+		measure("signature", "guard", 1000000, [&](auto) { git2pp::signature s(sig); });
+	}
+	{
+		git2pp::runtime rt;
+		measure("signature", "runtime", 1000000, [&](auto) { git2pp::signature s(sig); });
+	}
+
+
+	const auto dir = bench_directory("guard");
+	remove_directory(dir.c_str());
+
+	auto repo = git2pp::repository::init(dir, true);
+	git2pp::commit_tree_builder bld(repo);
+	bld.insert("file", repo.blob_create_from_buffer("libgit2++ bench\n"s), git2pp::filemode::blob);
+	const auto commit_id = repo.commit_create(sig, sig, "libgit2++ bench", repo.tree_lookup(bld.write()), std::vector<const git2pp::commit *>{});
+
+	measure("repository::commit_lookup", "guard", 1000000, [&](auto) { repo.commit_lookup(commit_id); });
+	{
+		git2pp::runtime rt;
+		measure("repository::commit_lookup", "runtime", 1000000, [&](auto) { repo.commit_lookup(commit_id); });
+	}
+}
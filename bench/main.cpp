@@ -0,0 +1,67 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "benchmarks.hpp"
+#include "libgit2++/guard.hpp"
+#include "util.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+
+static bool parse_size(const std::string & arg, const std::string & prefix, std::size_t & out) {
+	if(arg.compare(0, prefix.size(), prefix))
+		return false;
+
+	out = std::strtoull(arg.c_str() + prefix.size(), nullptr, 10);
+	return true;
+}
+
+
+int main(int argc, const char ** argv) {
+	fixture_parameters params;
+	for(auto i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		if(parse_size(arg, "--commits=", params.commits) || parse_size(arg, "--refs=", params.refs) || parse_size(arg, "--width=", params.width) ||
+		   parse_size(arg, "--depth=", params.depth) || parse_size(arg, "--multivars=", params.multivars))
+			continue;
+		else if(!arg.compare(0, 9, "--filter="))
+			select_benchmarks(arg.substr(9));
+		else {
+			std::fprintf(stderr, "Usage: %s [--commits=N] [--refs=N] [--width=N] [--depth=N] [--multivars=N] [--filter=BENCHMARK_SUBSTRING]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	guard_benchmarks();
+
+	git2pp::runtime rt;
+	const auto fxt = make_fixture(params);
+	repository_benchmarks(fxt);
+	commit_tree_benchmarks(fxt);
+	blob_benchmarks(fxt);
+	configuration_benchmarks(fxt);
+	commit_graph_benchmarks(fxt);
+	path_index_benchmarks(fxt);
+	fast_import_benchmarks(fxt);
+}
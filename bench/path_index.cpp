@@ -0,0 +1,62 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "benchmarks.hpp"
+#include "libgit2++/file_history.hpp"
+#include "libgit2++/path_index.hpp"
+#include "libgit2++/repository.hpp"
+#include "util.hpp"
+#include <algorithm>
+#include <cstdio>
+
+
+void path_index_benchmarks(const fixture & fxt) {
+	if(fxt.commit_ids.empty())
+		return;
+
+	auto repo        = git2pp::repository::open(fxt.path);
+	const auto path  = fxt.path + "path-index";
+	const auto & ids = fxt.commit_ids;
+	const auto older = ids[std::min<std::size_t>(100, ids.size() - 1)];
+
+	std::remove(path.c_str());
+	measure("path_index::update", "full", 1, [&](auto) {
+		git2pp::path_index index(repo, path);
+		index.update(older);
+		index.save();
+	});
+	measure("path_index::update", "100 new commits", 1, [&](auto) {
+		git2pp::path_index index(repo, path);
+		index.update(ids.front());
+		index.save();
+	});
+
+	// Every entry of the widest directory, against one of them the slow way
+	const git2pp::path_index index(repo, path);
+	const auto wide = repo.tree_lookup(repo.commit_lookup(ids.front()).tree().at_path("wide").id());
+	measure("path_index::last_modified", "path_index", 20, [&](auto) { index.last_modified(wide, "wide"); });
+	measure("path_index::last_modified", "file_history, one entry", 3, [&](auto) {
+		git2pp::file_history hist(repo, ids.front(), "wide/" + std::string(wide[0].name()));
+		hist.next();
+	});
+}
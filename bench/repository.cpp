@@ -0,0 +1,104 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "benchmarks.hpp"
+#include "libgit2++/detail/scope.hpp"
+#include "libgit2++/repository.hpp"
+#include "libgit2++/repository_pool.hpp"
+#include "util.hpp"
+#include <algorithm>
+#include <git2/blame.h>
+#include <git2/commit.h>
+#include <git2/refs.h>
+#include <vector>
+
+
+void repository_benchmarks(const fixture & fxt) {
+	auto repo = git2pp::repository::open(fxt.path);
+	git_repository * raw;
+	git_repository_open(&raw, fxt.path.c_str());
+	git2pp::detail::quickscope_wrapper raw_cleanup{[&]() { git_repository_free(raw); }};
+
+	const auto & ids = fxt.commit_ids;
+	if(!ids.empty()) {
+		// First pass fills each handle's object cache
+		for(auto && id : ids)
+			repo.commit_lookup(id);
+		measure("repository::commit_lookup", "libgit2++", ids.size(), [&](auto i) { repo.commit_lookup(ids[i]); });
+
+		for(auto && id : ids) {
+			git_commit * cmt;
+			git_commit_lookup(&cmt, raw, &id);
+			git_commit_free(cmt);
+		}
+		measure("repository::commit_lookup", "libgit2", ids.size(), [&](auto i) {
+			git_commit * cmt;
+			git_commit_lookup(&cmt, raw, &ids[i]);
+			git_commit_free(cmt);
+		});
+	}
+
+	if(ids.size() >= 512) {
+		// Separate pools so neither variant sees the other's warmed-up object caches
+		git2pp::repository_pool sequential_pool(fxt.path);
+		git2pp::repository_pool parallel_pool(fxt.path);
+		const auto batch = [&](auto i) { return std::vector<git_oid>(ids.begin() + i * 512, ids.begin() + (i + 1) * 512); };
+
+		measure("repository_pool::commit_lookup_many", "sequential", ids.size() / 512, [&](auto i) {
+			auto handle = sequential_pool.acquire();
+			for(auto && id : batch(i))
+				handle->commit_lookup(id);
+		});
+		measure("repository_pool::commit_lookup_many", "parallel", ids.size() / 512, [&](auto i) { parallel_pool.commit_lookup_many(batch(i)); });
+	}
+
+	measure("repository::reference_names", "libgit2++", 20, [&](auto) { repo.reference_names(); });
+	measure("repository::reference_names", "libgit2", 20, [&](auto) {
+		git_strarray names;
+		git_reference_list(&names, raw);
+		git_strarray_free(&names);
+	});
+
+	measure("repository::iterate_over_references", "libgit2++", 20, [&](auto) { repo.iterate_over_references([](const git2pp::reference &) { return 0; }); });
+	measure("repository::iterate_over_references", "libgit2", 20, [&](auto) {
+		git_reference_foreach(raw,
+		                      [](git_reference * ref, void *) {
+			                      git_reference_free(ref);
+			                      return 0;
+			                    },
+		                      nullptr);
+	});
+
+	if(!ids.empty()) {
+		git_blame_options opts = GIT_BLAME_OPTIONS_INIT;
+		opts.newest_commit     = ids.front();
+		opts.oldest_commit     = ids[std::min<std::size_t>(ids.size() - 1, 1000)];
+
+		measure("repository::blame_file", "libgit2++", 5, [&](auto) { repo.blame_file(fxt.hot_path, opts); });
+		measure("repository::blame_file", "libgit2", 5, [&](auto) {
+			git_blame * blm;
+			git_blame_file(&blm, raw, fxt.hot_path.c_str(), &opts);
+			git_blame_free(blm);
+		});
+	}
+}
@@ -0,0 +1,52 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+
+void remove_directory(const char * path);
+std::string bench_directory(const char * name);
+
+void select_benchmarks(std::string filter);
+bool benchmark_selected(const char * benchmark);
+void report(const char * benchmark, const char * variant, std::size_t iterations, std::chrono::nanoseconds elapsed);
+
+template <class F>
+void measure(const char * benchmark, const char * variant, std::size_t iterations, F && func);
+
+
+template <class F>
+void measure(const char * benchmark, const char * variant, std::size_t iterations, F && func) {
+	if(!benchmark_selected(benchmark))
+		return;
+
+	const auto start = std::chrono::steady_clock::now();
+	for(std::size_t i = 0; i < iterations; ++i)
+		func(i);
+	report(benchmark, variant, iterations, std::chrono::steady_clock::now() - start);
+}
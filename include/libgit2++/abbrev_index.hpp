@@ -0,0 +1,64 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "guard.hpp"
+#include "oid.hpp"
+#include "oid_set.hpp"
+#include <cstddef>
+#include <experimental/optional>
+#include <experimental/string_view>
+#include <string>
+#include <vector>
+
+
+namespace git2pp {
+	class repository;
+
+	// Snapshot of every object ID in the repository's object database, sorted so prefixes resolve with a binary search.
+	// Objects written afterwards are only seen after insert() or refresh()
+	class abbrev_index : public guard {
+	public:
+		// nullopt if hex isn't 1-40 hex digits, or matches no or more than one object
+		std::experimental::optional<oid> resolve_prefix(std::experimental::string_view hex) const noexcept;
+		std::vector<std::experimental::optional<oid>> resolve_prefixes(const std::vector<std::experimental::string_view> & hexes) const;
+
+		// Digits needed to tell id apart from every indexed object (that isn't id), but never fewer than min_len
+		std::size_t shortest_unique_abbrev(const oid & id, std::size_t min_len = 7) const noexcept;
+		std::vector<std::size_t> shortest_unique_abbrevs(const std::vector<oid> & ids, std::size_t min_len = 7) const;
+		std::string abbreviate(const oid & id, std::size_t min_len = 7) const;
+
+		std::size_t size() const noexcept;
+		void insert(const oid & id);
+		void insert_many(std::vector<oid> ids);
+		bool refresh() noexcept;
+
+		abbrev_index(repository & repo) noexcept;
+
+	private:
+		git_repository * repo;
+		oid_set ids;
+	};
+}
@@ -24,8 +24,12 @@
 #pragma once
 
 
+#include "buffer.hpp"
 #include "guard.hpp"
+#include <cstddef>
 #include <cstdint>
+#include <experimental/optional>
+#include <experimental/string_view>
 #include <git2/blob.h>
 #include <memory>
 #include <string>
@@ -39,24 +43,52 @@ namespace git2pp {
 		void operator()(git_blob * blb) const noexcept;
 	};
 
+	class blob_writer_deleter {
+	public:
+		void operator()(git_writestream * stream) const noexcept;
+	};
+
 
 	class repository;
 
 	class blob : public guard {
 	public:
+		bool valid() const noexcept;
 		bool binary() const noexcept;
 		const git_oid & id() const noexcept;
 		repository owner() const noexcept;
 
 		std::pair<const void *, std::uint64_t> raw() const noexcept;
+		// Points into libgit2's copy of the content, valid for as long as this blob is
+		std::experimental::string_view content() const noexcept;
 		std::string filtered(const char * as_path, bool check_for_binary_data = true);
 		std::string filtered(const std::string & as_path, bool check_for_binary_data = true);
+		// out's allocation is reused, and only grown if the result doesn't fit
+		bool filtered_into(buffer & out, const char * as_path, bool check_for_binary_data = true);
+		bool filtered_into(buffer & out, const std::string & as_path, bool check_for_binary_data = true);
 
 	private:
+		friend class repository_pool;
 		friend class repository;
 
 		blob(git_blob * blb, bool owning = true) noexcept;
 
 		std::unique_ptr<git_blob, blob_deleter> blb;
 	};
+
+	// Content is streamed to a temporary file in the object directory, so memory use doesn't depend on the blob's size
+	class blob_writer : public guard {
+	public:
+		bool write(const void * data, std::size_t size) noexcept;
+		bool write(const std::string & data) noexcept;
+		// Applies the hint path's filters and stores the blob; the writer can't be written to afterwards
+		std::experimental::optional<git_oid> commit() noexcept;
+
+	private:
+		friend class repository;
+
+		blob_writer(git_writestream * stream) noexcept;
+
+		std::unique_ptr<git_writestream, blob_writer_deleter> stream;
+	};
 }
@@ -0,0 +1,60 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "guard.hpp"
+#include <cstddef>
+#include <experimental/string_view>
+#include <git2/buffer.h>
+#include <string>
+
+
+namespace git2pp {
+	// Caller-owned output storage for libgit2 calls that fill a git_buf; passing the same buffer again reuses its allocation
+	class buffer : public guard {
+	public:
+		const char * data() const noexcept;
+		std::size_t size() const noexcept;
+		std::size_t capacity() const noexcept;
+		bool empty() const noexcept;
+
+		std::experimental::string_view view() const noexcept;
+		std::string str() const;
+
+		bool reserve(std::size_t size) noexcept;
+
+		buffer() noexcept;
+		buffer(const buffer &) = delete;
+		buffer(buffer && other) noexcept;
+		~buffer();
+
+		buffer & operator=(buffer && other) noexcept;
+
+	private:
+		friend class blob;
+
+		git_buf buf;
+	};
+}
@@ -56,6 +56,7 @@ namespace git2pp {
 
 	class commit : public guard {
 	public:
+		bool valid() const noexcept;
 		const git_oid & id() const noexcept;
 		repository owner() const noexcept;
 		std::pair<std::chrono::time_point<std::chrono::system_clock>, int> time() const noexcept;
@@ -81,6 +82,8 @@ namespace git2pp {
 		std::string header_field(const std::string & field) const;
 
 	private:
+		friend class repository_pool;
+		friend class lookup_cache;
 		friend class repository;
 
 		commit(git_commit * cmt, bool owning = true) noexcept;
@@ -0,0 +1,131 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "guard.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <experimental/optional>
+#include <experimental/string_view>
+#include <git2/oid.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace git2pp {
+	class repository;
+
+	struct commit_graph_ahead_behind {
+		std::size_t ahead;
+		std::size_t behind;
+		// A best common ancestor, absent if there's no shared history
+		std::experimental::optional<std::uint32_t> merge_base;
+	};
+
+	// Git's commit-graph file: the ID, root tree, parents, commit time and generation number of every commit reachable from whatever it was written from,
+	// sorted by ID. The file is mapped read-only, so nothing is parsed or inflated to answer graph queries.
+	// Commits are addressed by their position in the graph, which stays valid for as long as the file isn't rewritten
+	class commit_graph : public guard {
+	public:
+		// Generation numbers saturate here, past it they stop meaning anything
+		static constexpr std::uint32_t generation_max = 0x3FFFFFFF;
+
+
+		// Every commit reachable from tips (every reference and HEAD by default) goes to path (the repository's objects/info/commit-graph by default).
+		// Commits are read breadth-first, a whole frontier at a time split across threads; 0 threads means one per core.
+		// changed_paths adds Git's changed-path Bloom filters, each commit diffed against its first parent on the same threads
+		static bool write(repository & repo, std::size_t threads = 0, bool changed_paths = false);
+		static bool write(repository & repo, const std::vector<git_oid> & tips, const std::string & path, std::size_t threads = 0,
+		                  bool changed_paths = false);
+
+		// False if the file is missing or malformed, nothing else may be called then
+		bool valid() const noexcept;
+		// Checks the trailing checksum, which valid() doesn't
+		bool verify() const noexcept;
+		std::uint32_t size() const noexcept;
+
+		std::experimental::optional<std::uint32_t> position(const git_oid & id) const noexcept;
+		const git_oid & id(std::uint32_t pos) const noexcept;
+		const git_oid & tree_id(std::uint32_t pos) const noexcept;
+		// Committer time in seconds since the epoch
+		std::int64_t time(std::uint32_t pos) const noexcept;
+		// 1 for root commits, otherwise 1 more than the highest of the parents'
+		std::uint32_t generation(std::uint32_t pos) const noexcept;
+
+		std::uint32_t parent_count(std::uint32_t pos) const noexcept;
+		std::uint32_t parent(std::uint32_t pos, std::uint32_t n) const noexcept;
+		std::vector<std::uint32_t> parents(std::uint32_t pos) const;
+		template <class F>
+		void for_each_parent(std::uint32_t pos, F && func) const;
+
+		bool has_changed_paths() const noexcept;
+		// False only if the commit's Bloom filter rules out path (slash-separated, relative to the root) differing from its first parent.
+		// True for commits without a usable filter and in graphs without any
+		bool maybe_changed(std::uint32_t pos, std::experimental::string_view path) const noexcept;
+
+		bool is_ancestor(std::uint32_t ancestor, std::uint32_t descendant) const;
+		// False if either isn't in the graph
+		bool is_ancestor(const git_oid & ancestor, const git_oid & descendant) const;
+
+		// For each tip: commits reachable from it but not from base (ahead), the other way around (behind), and their merge base.
+		// Up to 63 tips share one walk in generation order, separate walks are split across threads; 0 threads means one per core.
+		// Exact as long as no generation number has saturated
+		std::vector<commit_graph_ahead_behind> ahead_behind(std::uint32_t base, const std::vector<std::uint32_t> & tips, std::size_t threads = 0) const;
+		commit_graph_ahead_behind ahead_behind(std::uint32_t base, std::uint32_t tip) const;
+		// Absent for tips that aren't in the graph, all absent if base isn't
+		std::vector<std::experimental::optional<commit_graph_ahead_behind>> ahead_behind(const git_oid & base, const std::vector<git_oid> & tips,
+		                                                                                 std::size_t threads = 0) const;
+
+		commit_graph(repository & repo);
+		commit_graph(const char * path);
+		commit_graph(const std::string & path);
+
+	private:
+		void load() noexcept;
+
+		std::shared_ptr<const unsigned char> file;
+		std::size_t file_size;
+
+		const unsigned char * fanout;
+		const git_oid * ids;
+		const unsigned char * commit_data;
+		const unsigned char * extra_edges;
+		std::size_t extra_edges_count;
+		const unsigned char * bloom_index;
+		const unsigned char * bloom_data;
+		std::size_t bloom_data_size;
+		std::uint32_t bloom_hashes;
+		std::uint32_t count;
+	};
+}
+
+
+template <class F>
+void git2pp::commit_graph::for_each_parent(std::uint32_t pos, F && func) const {
+	const auto amount = parent_count(pos);
+	for(std::uint32_t i = 0; i < amount; ++i)
+		func(parent(pos, i));
+}
@@ -75,6 +75,7 @@ namespace git2pp {
 
 	class commit_tree : public guard {
 	public:
+		bool valid() const noexcept;
 		const git_oid & id() const noexcept;
 		repository owner() const noexcept;
 
@@ -93,7 +94,9 @@ namespace git2pp {
 	private:
 		friend class commit;
 		friend class repository;
+		friend class repository_pool;
 		friend class commit_tree_builder;
+		friend class lookup_cache;
 
 		commit_tree(git_tree * trr, bool owning = true) noexcept;
 
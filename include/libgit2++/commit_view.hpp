@@ -0,0 +1,116 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "odb.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <experimental/optional>
+#include <experimental/string_view>
+#include <git2/oid.h>
+#include <iterator>
+
+
+namespace git2pp {
+	// A commit's raw object, parsed only as far as each accessor needs: tree_id() reads the first line, parent_ids() the ones right after it,
+	// everything else scans the header up to its field. Nothing is allocated or copied, so the data has to outlive the view
+	class commit_view {
+	public:
+		class parent_iterator {
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type        = git_oid;
+			using difference_type   = std::ptrdiff_t;
+			using pointer           = const git_oid *;
+			using reference         = git_oid;
+
+			// Parsed on every dereference
+			git_oid operator*() const noexcept;
+			parent_iterator & operator++() noexcept;
+			parent_iterator operator++(int) noexcept;
+
+			bool operator==(const parent_iterator & other) const noexcept;
+			bool operator!=(const parent_iterator & other) const noexcept;
+
+		private:
+			friend class commit_view;
+
+			parent_iterator(const char * line, const char * end) noexcept;
+
+			const char * line;
+			const char * end;
+		};
+
+		struct parent_range {
+			parent_iterator first;
+			parent_iterator last;
+
+			parent_iterator begin() const noexcept;
+			parent_iterator end() const noexcept;
+		};
+
+
+		// False unless the header starts with a well-formed tree line, nothing else is meaningful then
+		bool valid() const noexcept;
+		std::experimental::string_view raw() const noexcept;
+
+		git_oid tree_id() const noexcept;
+		parent_range parent_ids() const noexcept;
+		std::size_t parent_count() const noexcept;
+		std::experimental::optional<git_oid> parent_id(std::size_t n) const noexcept;
+
+		// Committer time in seconds since the epoch, 0 if there's none
+		std::int64_t time() const noexcept;
+		// Committer timezone in minutes east of UTC
+		int time_offset() const noexcept;
+
+		// "Name <email> 1234567890 +0000", as stored
+		std::experimental::string_view author() const noexcept;
+		std::experimental::string_view committer() const noexcept;
+		// Value of the first header line starting with name and a space; multi-line values (like gpgsig) are cut at the first line
+		std::experimental::string_view header(std::experimental::string_view name) const noexcept;
+		// Everything after the header, empty if there's none
+		std::experimental::string_view message() const noexcept;
+
+		constexpr commit_view() noexcept : data(nullptr), end(nullptr) {}
+		commit_view(const char * data, std::size_t size) noexcept;
+		commit_view(std::experimental::string_view raw) noexcept;
+		// obj has to be a commit
+		commit_view(const odb_object & obj) noexcept;
+
+	private:
+		static constexpr std::size_t tree_line_size   = 5 + GIT_OID_HEXSZ + 1;
+		static constexpr std::size_t parent_line_size = 7 + GIT_OID_HEXSZ + 1;
+
+		static const char * line_end(const char * line, const char * end) noexcept;
+		// Right past the parent lines, where author, committer and the other fields start
+		const char * fields() const noexcept;
+		// Where the committer line's time starts, with the line itself put in line; null if there's no committer line
+		const char * committer_time(std::experimental::string_view & line) const noexcept;
+
+		const char * data;
+		const char * end;
+	};
+}
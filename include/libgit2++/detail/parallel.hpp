@@ -0,0 +1,75 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+
+namespace git2pp {
+	namespace detail {
+		// requested=0 means one per core; never more threads than there are min_per_thread-sized slices
+		std::size_t thread_count(std::size_t count, std::size_t requested, std::size_t min_per_thread = 1) noexcept;
+
+		// Calls func(thread_idx, begin, end) over contiguous slices of [0, count), the first slice on the calling thread.
+		// Rethrows the first exception any slice threw after all of them are done.
+		template <class F>
+		void parallel_for(std::size_t count, std::size_t threads, F && func);
+	}
+}
+
+
+template <class F>
+void git2pp::detail::parallel_for(std::size_t count, std::size_t threads, F && func) {
+	threads = std::max<std::size_t>(std::min(threads, count), 1);
+	if(threads == 1) {
+		func(std::size_t{0}, std::size_t{0}, count);
+		return;
+	}
+
+	std::vector<std::exception_ptr> errors(threads);
+	const auto run = [&](std::size_t idx) {
+		try {
+			func(idx, count * idx / threads, count * (idx + 1) / threads);
+		} catch(...) {
+			errors[idx] = std::current_exception();
+		}
+	};
+
+	std::vector<std::thread> workers;
+	workers.reserve(threads - 1);
+	for(std::size_t i = 1; i < threads; ++i)
+		workers.emplace_back(run, i);
+	run(0);
+	for(auto && worker : workers)
+		worker.join();
+
+	for(auto && error : errors)
+		if(error)
+			std::rethrow_exception(error);
+}
@@ -0,0 +1,51 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <experimental/optional>
+#include <experimental/string_view>
+#include <git2/odb.h>
+#include <git2/oid.h>
+#include <string>
+#include <vector>
+
+
+namespace git2pp {
+	namespace detail {
+		// Trees are read straight from the object database, so these are safe to run on several threads over one git_odb
+
+		// Every path whose entry differs between the two trees, and every directory leading to one, the way Git's changed-path Bloom filters count them;
+		// a null tree is an empty one. Stops early once there are more than limit of them (0 means no limit).
+		// If ids is given, it gets what each path points to in new_tree, a zero ID where it's gone.
+		// Absent if a tree couldn't be read
+		std::experimental::optional<std::vector<std::string>> changed_paths(git_odb * db, const git_oid * old_tree, const git_oid * new_tree,
+		                                                                   std::size_t limit = 0, std::vector<git_oid> * ids = nullptr);
+
+		// Entry at a slash-separated path, false if there's none
+		bool tree_entry_at(git_odb * db, const git_oid & tree, std::experimental::string_view path, git_oid & id, std::uint32_t & mode);
+	}
+}
@@ -0,0 +1,126 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "commit_tree.hpp"
+#include "guard.hpp"
+#include "mempack.hpp"
+#include "odb.hpp"
+#include "repository.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <experimental/optional>
+#include <git2/oid.h>
+#include <git2/types.h>
+#include <istream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace git2pp {
+	// Bulk history ingest, the way git fast-import does it: each branch keeps its tree in memory between commits, so a commit only writes the trees
+	// on the paths it changed. Objects are kept in memory and go into a pack of their own every batch_objects of them (or at finish()) instead of
+	// one loose file each, and nothing's visible under any reference until finish() moves all of them in one transaction.
+	// Works on a handle of its own, so the repository it's made from is left alone; failures are sticky and make finish() fail
+	class fast_import : public guard {
+	public:
+		git_oid blob(const void * data, std::size_t size);
+		git_oid blob(const std::string & data);
+
+		// Changes for the next commit, applied in order to the tree of whichever branch that goes to.
+		// Paths are slash-separated; a tree mode puts a whole tree at path, and empty directories disappear the same way they do in Git
+		void file_modify(const std::string & path, const git_oid & id, filemode mode = filemode::blob);
+		void file_delete(const std::string & path);
+		void file_rename(const std::string & from, const std::string & to);
+		void file_copy(const std::string & from, const std::string & to);
+		void file_delete_all();
+
+		// The next commit on ref has from as its first parent and starts from its tree.
+		// Without one the branch starts over with no parents and an empty tree
+		bool reset(const std::string & ref, const git_oid & from);
+		void reset(const std::string & ref);
+
+		// A branch not seen before starts from where ref points in the repository, if anywhere. The zero ID on failure
+		git_oid commit(const std::string & ref, const git_signature & author, const git_signature & committer, const std::string & message,
+		               const std::vector<git_oid> & merges = {});
+
+		// Where ref is about to point
+		std::experimental::optional<git_oid> tip(const std::string & ref) const;
+
+		// The blob, commit, reset, checkpoint, progress and done commands of a git fast-import stream, with marks.
+		// False on anything else or malformed, everything before it stays
+		bool parse(std::istream & in);
+
+		// Packs what's left and points every branch committed to or reset at its tip, all in one transaction.
+		// Like git fast-import without --force, nothing moves if that's not a fast-forward for one of them unless force; that failure isn't sticky
+		bool finish(bool force = false);
+
+		fast_import(repository & repo, std::size_t batch_objects = 50000);
+		~fast_import();
+
+	private:
+		struct tree_node;
+		struct change {
+			enum class kind { modify, remove, rename, copy, remove_all };
+
+			kind what;
+			std::string path;
+			std::string from;
+			git_oid id;
+			std::uint32_t mode;
+		};
+		struct branch {
+			git_oid tip;
+			std::unique_ptr<tree_node> root;
+			bool updated;
+		};
+
+		branch & branch_for(const std::string & ref);
+		// Points br at from and its tree; false if from isn't a commit
+		bool start_from(branch & br, const git_oid & from);
+		bool load(tree_node & node);
+		// Trees down to the one path's in, last; false if one's missing and not to be created
+		bool descend(tree_node & root, const std::string & path, bool create, std::vector<tree_node *> & chain);
+		bool apply(tree_node & root, const change & chg);
+		std::experimental::optional<git_oid> write_tree(tree_node & node);
+		git_oid write(const void * data, std::size_t size, git_otype type);
+		bool flush();
+
+		repository repo;
+		mempack pack;
+		std::unique_ptr<git_odb, odb_deleter> db;
+		std::size_t batch_objects;
+		std::size_t batched_objects;
+		std::size_t batched_bytes;
+		bool failed;
+
+		std::map<std::string, branch> branches;
+		std::vector<change> changes;
+		std::unordered_map<std::uintmax_t, git_oid> marks;
+	};
+}
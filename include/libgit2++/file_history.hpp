@@ -0,0 +1,98 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "guard.hpp"
+#include "odb.hpp"
+#include "revwalk.hpp"
+#include <cstddef>
+#include <experimental/optional>
+#include <git2/oid.h>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace git2pp {
+	class commit_graph;
+	class repository;
+
+	// Commits whose entry at a path differs from the one in every parent (or that have one at all, for root commits), children before parents,
+	// found one at a time as they're asked for. Commits a graph's changed-path filters rule out are skipped without reading a single tree,
+	// and parents and trees of commits in the graph come from it instead of the object database.
+	// When following renames, a commit that adds the path switches the search over to whatever it was renamed from, the same way git log --follow does
+	class file_history : public guard {
+	public:
+		class iterator {
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type        = git_oid;
+			using difference_type   = std::ptrdiff_t;
+			using pointer           = const git_oid *;
+			using reference         = const git_oid &;
+
+			reference operator*() const noexcept;
+			pointer operator->() const noexcept;
+			iterator & operator++();
+			iterator operator++(int);
+
+			bool operator==(const iterator & other) const noexcept;
+			bool operator!=(const iterator & other) const noexcept;
+
+		private:
+			friend class file_history;
+
+			iterator(file_history * history);
+
+			file_history * history;
+			git_oid current;
+		};
+
+
+		std::experimental::optional<git_oid> next();
+		// Where the path was in the commit next() last produced
+		const std::string & path() const noexcept;
+
+		// Input range: begin() looks for the first commit and there's only a single pass
+		iterator begin();
+		iterator end();
+
+		// graph has to outlive the history
+		file_history(repository & repo, const git_oid & start, std::string path, bool follow_renames = false, const commit_graph * graph = nullptr);
+
+	private:
+		bool read_commit(const git_oid & id, git_oid & tree, std::vector<git_oid> & parents) const;
+
+		git_repository * repo;
+		std::unique_ptr<git_odb, odb_deleter> db;
+		revwalk walk;
+		const commit_graph * graph;
+		bool follow_renames;
+		// Where the path is in commits yet to be looked at, and where it was in the last one produced
+		std::string searched_path;
+		std::string found_path;
+	};
+}
@@ -25,9 +25,29 @@
 
 
 namespace git2pp {
+	// Keeps libgit2 initialised for its whole lifetime; while at least one is alive guards skip git_libgit2_init()/git_libgit2_shutdown() entirely.
+	// Must outlive every wrapper created while it's alive.
+	class runtime {
+	public:
+		static bool active() noexcept;
+
+		runtime();
+		runtime(const runtime & other);
+		~runtime();
+
+		runtime & operator=(const runtime &) noexcept;
+	};
+
+
 	class guard {
 	public:
 		guard();
+		guard(const guard & other);
 		~guard();
+
+		guard & operator=(const guard &) noexcept;
+
+	private:
+		bool initialised;
 	};
 }
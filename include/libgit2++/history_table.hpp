@@ -0,0 +1,61 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "guard.hpp"
+#include "signature_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <git2/oid.h>
+#include <vector>
+
+
+namespace git2pp {
+	class repository;
+	class revwalk;
+
+	// Commit metadata for a whole walk, one column per field and one row per commit, in the order the walk produced them.
+	// The parents of row i are parent_ids[parent_offsets[i]] up to parent_ids[parent_offsets[i + 1]]; authors and committers index people
+	class history_table : public guard {
+	public:
+		std::vector<git_oid> ids;
+		std::vector<git_oid> tree_ids;
+		// Committer time in seconds since the epoch and its timezone in minutes east of UTC
+		std::vector<std::int64_t> times;
+		std::vector<std::int32_t> time_offsets;
+		std::vector<signature_pool::handle> authors;
+		std::vector<signature_pool::handle> committers;
+		// One more entry than there are rows
+		std::vector<std::uint32_t> parent_offsets;
+		std::vector<git_oid> parent_ids;
+		signature_pool people;
+
+		std::size_t size() const noexcept;
+
+		// Drains walk first, then reads and parses the commits in parallel from the object database; 0 threads means one per core.
+		// Empty if any commit couldn't be read
+		history_table(repository & repo, revwalk & walk, std::size_t threads = 0);
+	};
+}
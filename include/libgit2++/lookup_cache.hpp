@@ -0,0 +1,88 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "commit.hpp"
+#include "commit_tree.hpp"
+#include "guard.hpp"
+#include "oid.hpp"
+#include "oid_map.hpp"
+#include <cstddef>
+#include <list>
+#include <memory>
+
+
+namespace git2pp {
+	class repository;
+
+	struct lookup_cache_stats {
+		std::size_t hits;
+		std::size_t misses;
+		std::size_t evictions;
+		std::size_t entries;
+		std::size_t bytes;
+	};
+
+
+	// Keeps the most recently used commits and trees of a repository alive within a byte budget, least recently used going first.
+	// Handed-out objects stay valid past eviction, but not past the repository; not thread-safe, same as the repository
+	class lookup_cache : public guard {
+	public:
+		// nullptr if the object doesn't exist or isn't of that type
+		std::shared_ptr<const commit> commit_lookup(const git_oid & id);
+		std::shared_ptr<const commit_tree> tree_lookup(const git_oid & id);
+
+		lookup_cache_stats stats() const noexcept;
+		void reset_stats() noexcept;
+
+		std::size_t budget() const noexcept;
+		void budget(std::size_t bytes);
+		void clear() noexcept;
+
+		lookup_cache(repository & repo, std::size_t budget = 16 * 1024 * 1024);
+
+	private:
+		struct entry {
+			oid id;
+			std::shared_ptr<const commit> cmt;
+			std::shared_ptr<const commit_tree> trr;
+			std::size_t cost;
+		};
+
+		entry * find(const oid & id) noexcept;
+		void insert(entry ent);
+		void shrink() noexcept;
+
+		git_repository * repo;
+		// Most recently used first
+		std::list<entry> lru;
+		oid_map<std::list<entry>::iterator> index;
+		std::size_t max_bytes;
+		std::size_t bytes;
+		std::size_t hits;
+		std::size_t misses;
+		std::size_t evictions;
+	};
+}
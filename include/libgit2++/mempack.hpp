@@ -0,0 +1,59 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "guard.hpp"
+#include "odb.hpp"
+#include <cstddef>
+#include <git2/sys/mempack.h>
+#include <memory>
+
+
+namespace git2pp {
+	class repository;
+
+	// Captures every object written to the repository in memory until flush() packs them into a single .pack/.idx pair.
+	// libgit2 can't detach a backend, so once the mempack is destroyed (flushing one last time) writes are passed on to the object directory instead.
+	class mempack : public guard {
+	public:
+		// False if it couldn't be set up, in which case nothing's captured and writes go to the object directory as usual
+		bool valid() const noexcept;
+		std::size_t flush() noexcept;
+		void reset() noexcept;
+		// Objects written since the last flush() or reset(); flush() leaves them all there if it fails
+		std::size_t pending() const noexcept;
+
+		mempack(repository & repo, int priority = 999) noexcept;
+		mempack(const mempack &) = delete;
+		~mempack();
+
+	private:
+		git_repository * repo;
+		std::unique_ptr<git_odb, odb_deleter> db;
+		git_odb_backend * backend;
+		// In front of the backend, writing to it and noting what it got
+		git_odb_backend * recorder;
+	};
+}
@@ -33,6 +33,7 @@
 
 namespace git2pp {
 	class repository;
+	class abbrev_index;
 
 
 	enum class object_type {
@@ -62,16 +63,21 @@ namespace git2pp {
 
 	class object : public guard {
 		friend class commit_tree_entry;
+		friend class repository_pool;
 		friend class reference;
 		friend class repository;
 
 
 	public:
+		// False for what a failed lookup gave back
+		bool valid() const noexcept;
 		object lookup_by_path(const char * path, object_type type) const noexcept;
 		object lookup_by_path(const std::string & path, object_type type) const noexcept;
 
 		const git_oid & id() const noexcept;
 		std::string short_id() const;
+		// Ignores core.abbrev, but doesn't touch the object database
+		std::string short_id(const abbrev_index & index) const;
 		object_type type() const noexcept;
 
 		repository owner() const noexcept;
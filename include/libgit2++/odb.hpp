@@ -0,0 +1,90 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "guard.hpp"
+#include "object.hpp"
+#include <cstddef>
+#include <experimental/optional>
+#include <git2/odb.h>
+#include <memory>
+#include <vector>
+
+
+namespace git2pp {
+	class odb_deleter {
+	public:
+		void operator()(git_odb * db) const noexcept;
+	};
+
+	class odb_object_deleter {
+	public:
+		void operator()(git_odb_object * obj) const noexcept;
+	};
+
+
+	struct odb_header {
+		object_type type;
+		std::size_t size;
+	};
+
+
+	class odb_object : public guard {
+	public:
+		const git_oid & id() const noexcept;
+		object_type type() const noexcept;
+		std::size_t size() const noexcept;
+		const void * data() const noexcept;
+
+	private:
+		friend class odb;
+
+		odb_object(git_odb_object * obj) noexcept;
+
+		std::unique_ptr<git_odb_object, odb_object_deleter> obj;
+	};
+
+	class odb : public guard {
+	public:
+		std::experimental::optional<odb_header> read_header(const git_oid & id) const noexcept;
+		std::vector<std::experimental::optional<odb_header>> read_headers(const std::vector<git_oid> & ids) const;
+
+		bool exists(const git_oid & id) const noexcept;
+		std::vector<bool> exists_many(const std::vector<git_oid> & ids) const;
+		std::experimental::optional<git_oid> exists_prefix(const git_oid & id, std::size_t prefix_len) const noexcept;
+
+		odb_object read(const git_oid & id) const noexcept;
+		odb_object read_prefix(const git_oid & id, std::size_t prefix_len) const noexcept;
+
+		void refresh() noexcept;
+
+	private:
+		friend class repository;
+
+		odb(git_odb * db) noexcept;
+
+		std::unique_ptr<git_odb, odb_deleter> db;
+	};
+}
@@ -0,0 +1,118 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstring>
+#include <experimental/optional>
+#include <experimental/string_view>
+#include <functional>
+#include <git2/oid.h>
+#include <stdexcept>
+#include <string>
+
+
+namespace git2pp {
+	namespace detail {
+		constexpr int hex_value(char c) noexcept {
+			return (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+		}
+	}
+
+
+	// Layout-compatible with git_oid, so it converts both ways for free
+	class oid {
+	public:
+		static constexpr std::size_t size     = GIT_OID_RAWSZ;
+		static constexpr std::size_t hex_size = GIT_OID_HEXSZ;
+
+
+		// Exactly hex_size hex digits of either case
+		static std::experimental::optional<oid> from_hex(std::experimental::string_view hex) noexcept;
+		// Compile-time when used in a constant expression, throws std::invalid_argument otherwise
+		static constexpr oid from_hex_literal(const char * hex, std::size_t len);
+
+		const unsigned char * data() const noexcept;
+		bool zero() const noexcept;
+
+		// Lowercase, NUL-terminated
+		void to_hex(char (&out)[hex_size + 1]) const noexcept;
+		std::string str() const;
+
+		// <0, 0 or >0, like memcmp
+		int compare(const oid & other) const noexcept;
+
+		operator const git_oid &() const noexcept;
+
+		constexpr oid() noexcept : raw{} {}
+		oid(const git_oid & id) noexcept;
+
+	private:
+		git_oid raw;
+	};
+
+	bool operator==(const oid & lhs, const oid & rhs) noexcept;
+	bool operator!=(const oid & lhs, const oid & rhs) noexcept;
+	bool operator<(const oid & lhs, const oid & rhs) noexcept;
+	bool operator<=(const oid & lhs, const oid & rhs) noexcept;
+	bool operator>(const oid & lhs, const oid & rhs) noexcept;
+	bool operator>=(const oid & lhs, const oid & rhs) noexcept;
+
+	namespace literals {
+		constexpr oid operator""_oid(const char * hex, std::size_t len);
+	}
+}
+
+namespace std {
+	// SHA-1 output is already uniformly distributed, so any of its words is as good a hash as any
+	template <>
+	struct hash<git2pp::oid> {
+		std::size_t operator()(const git2pp::oid & id) const noexcept {
+			std::size_t result;
+			std::memcpy(&result, id.data(), sizeof(result));
+			return result;
+		}
+	};
+}
+
+
+constexpr git2pp::oid git2pp::oid::from_hex_literal(const char * hex, std::size_t len) {
+	if(len != hex_size)
+		throw std::invalid_argument("OID literal must be 40 hex digits");
+
+	oid result;
+	for(std::size_t i = 0; i < size; ++i) {
+		const auto high = detail::hex_value(hex[i * 2]);
+		const auto low  = detail::hex_value(hex[i * 2 + 1]);
+		if(high < 0 || low < 0)
+			throw std::invalid_argument("OID literal must be 40 hex digits");
+		result.raw.id[i] = static_cast<unsigned char>((high << 4) | low);
+	}
+	return result;
+}
+
+constexpr git2pp::oid git2pp::literals::operator""_oid(const char * hex, std::size_t len) {
+	return oid::from_hex_literal(hex, len);
+}
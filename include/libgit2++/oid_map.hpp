@@ -0,0 +1,312 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "oid.hpp"
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace git2pp {
+	// Open addressing with linear probing, keys stored inline next to their values.
+	// The home slot comes straight from the OID's bytes; erasure shifts back instead of leaving tombstones.
+	// V needs to be default-constructible, and iterators and pointers are invalidated by any insertion or erasure
+	template <class V>
+	class oid_map {
+	public:
+		using value_type = std::pair<oid, V>;
+
+		template <class T>
+		class basic_iterator {
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type        = std::remove_const_t<T>;
+			using difference_type   = std::ptrdiff_t;
+			using pointer           = T *;
+			using reference         = T &;
+
+			reference operator*() const noexcept;
+			pointer operator->() const noexcept;
+			basic_iterator & operator++() noexcept;
+			basic_iterator operator++(int) noexcept;
+
+			bool operator==(const basic_iterator & other) const noexcept;
+			bool operator!=(const basic_iterator & other) const noexcept;
+
+		private:
+			friend class oid_map;
+
+			basic_iterator(T * slot, const unsigned char * used, const unsigned char * used_end) noexcept;
+
+			T * slot;
+			const unsigned char * used;
+			const unsigned char * used_end;
+		};
+
+		using iterator       = basic_iterator<value_type>;
+		using const_iterator = basic_iterator<const value_type>;
+
+
+		V * find(const oid & key) noexcept;
+		const V * find(const oid & key) const noexcept;
+		bool contains(const oid & key) const noexcept;
+
+		// Default-constructs a missing value
+		V & operator[](const oid & key);
+		// Returns the value for key and whether it was newly inserted; an existing value is left alone
+		std::pair<V &, bool> insert(const oid & key, V value);
+		bool erase(const oid & key);
+
+		std::size_t size() const noexcept;
+		bool empty() const noexcept;
+		void clear() noexcept;
+		void reserve(std::size_t count);
+
+		iterator begin() noexcept;
+		iterator end() noexcept;
+		const_iterator begin() const noexcept;
+		const_iterator end() const noexcept;
+
+		oid_map() noexcept;
+		oid_map(std::size_t count);
+
+	private:
+		std::size_t home(const oid & key) const noexcept;
+		// Slot holding key or the empty slot it'd go in
+		std::size_t probe(const oid & key) const noexcept;
+		void rehash(std::size_t capacity);
+
+		std::vector<value_type> slots;
+		std::vector<unsigned char> used;
+		std::size_t count;
+	};
+}
+
+
+template <class V>
+template <class T>
+auto git2pp::oid_map<V>::basic_iterator<T>::operator*() const noexcept -> reference {
+	return *slot;
+}
+
+template <class V>
+template <class T>
+auto git2pp::oid_map<V>::basic_iterator<T>::operator->() const noexcept -> pointer {
+	return slot;
+}
+
+template <class V>
+template <class T>
+auto git2pp::oid_map<V>::basic_iterator<T>::operator++() noexcept -> basic_iterator & {
+	do {
+		++slot;
+		++used;
+	} while(used != used_end && !*used);
+	return *this;
+}
+
+template <class V>
+template <class T>
+auto git2pp::oid_map<V>::basic_iterator<T>::operator++(int) noexcept -> basic_iterator {
+	auto prev = *this;
+	++*this;
+	return prev;
+}
+
+template <class V>
+template <class T>
+bool git2pp::oid_map<V>::basic_iterator<T>::operator==(const basic_iterator & other) const noexcept {
+	return used == other.used;
+}
+
+template <class V>
+template <class T>
+bool git2pp::oid_map<V>::basic_iterator<T>::operator!=(const basic_iterator & other) const noexcept {
+	return used != other.used;
+}
+
+template <class V>
+template <class T>
+git2pp::oid_map<V>::basic_iterator<T>::basic_iterator(T * s, const unsigned char * u, const unsigned char * ue) noexcept : slot(s), used(u), used_end(ue) {
+	while(used != used_end && !*used) {
+		++slot;
+		++used;
+	}
+}
+
+
+template <class V>
+V * git2pp::oid_map<V>::find(const oid & key) noexcept {
+	return const_cast<V *>(static_cast<const oid_map &>(*this).find(key));
+}
+
+template <class V>
+const V * git2pp::oid_map<V>::find(const oid & key) const noexcept {
+	if(!count)
+		return nullptr;
+
+	const auto idx = probe(key);
+	return used[idx] ? &slots[idx].second : nullptr;
+}
+
+template <class V>
+bool git2pp::oid_map<V>::contains(const oid & key) const noexcept {
+	return find(key);
+}
+
+template <class V>
+V & git2pp::oid_map<V>::operator[](const oid & key) {
+	return insert(key, V{}).first;
+}
+
+template <class V>
+std::pair<V &, bool> git2pp::oid_map<V>::insert(const oid & key, V value) {
+	// Keep the load factor at or under 3/4
+	if((count + 1) * 4 > slots.size() * 3)
+		rehash(slots.empty() ? 16 : slots.size() * 2);
+
+	const auto idx = probe(key);
+	if(used[idx])
+		return {slots[idx].second, false};
+
+	slots[idx].first  = key;
+	slots[idx].second = std::move(value);
+	used[idx]         = true;
+	++count;
+	return {slots[idx].second, true};
+}
+
+template <class V>
+bool git2pp::oid_map<V>::erase(const oid & key) {
+	if(!count)
+		return false;
+
+	auto hole = probe(key);
+	if(!used[hole])
+		return false;
+	used[hole]         = false;
+	slots[hole].second = V{};
+	--count;
+
+	// Pull every following entry of the cluster that can't be found past the hole back into it
+	const auto mask = slots.size() - 1;
+	for(auto idx = (hole + 1) & mask; used[idx]; idx = (idx + 1) & mask) {
+		const auto wanted = home(slots[idx].first);
+		if(((idx - wanted) & mask) >= ((idx - hole) & mask)) {
+			slots[hole] = std::move(slots[idx]);
+			used[hole]  = true;
+			used[idx]   = false;
+			hole        = idx;
+		}
+	}
+	return true;
+}
+
+template <class V>
+std::size_t git2pp::oid_map<V>::size() const noexcept {
+	return count;
+}
+
+template <class V>
+bool git2pp::oid_map<V>::empty() const noexcept {
+	return !count;
+}
+
+template <class V>
+void git2pp::oid_map<V>::clear() noexcept {
+	slots.clear();
+	used.clear();
+	count = 0;
+}
+
+template <class V>
+void git2pp::oid_map<V>::reserve(std::size_t wanted) {
+	std::size_t capacity = 16;
+	while(wanted * 4 > capacity * 3)
+		capacity *= 2;
+	if(capacity > slots.size())
+		rehash(capacity);
+}
+
+template <class V>
+auto git2pp::oid_map<V>::begin() noexcept -> iterator {
+	return {slots.data(), used.data(), used.data() + used.size()};
+}
+
+template <class V>
+auto git2pp::oid_map<V>::end() noexcept -> iterator {
+	return {slots.data() + slots.size(), used.data() + used.size(), used.data() + used.size()};
+}
+
+template <class V>
+auto git2pp::oid_map<V>::begin() const noexcept -> const_iterator {
+	return {slots.data(), used.data(), used.data() + used.size()};
+}
+
+template <class V>
+auto git2pp::oid_map<V>::end() const noexcept -> const_iterator {
+	return {slots.data() + slots.size(), used.data() + used.size(), used.data() + used.size()};
+}
+
+template <class V>
+git2pp::oid_map<V>::oid_map() noexcept : count(0) {}
+
+template <class V>
+git2pp::oid_map<V>::oid_map(std::size_t wanted) : oid_map() {
+	reserve(wanted);
+}
+
+template <class V>
+std::size_t git2pp::oid_map<V>::home(const oid & key) const noexcept {
+	return std::hash<oid>{}(key) & (slots.size() - 1);
+}
+
+template <class V>
+std::size_t git2pp::oid_map<V>::probe(const oid & key) const noexcept {
+	const auto mask = slots.size() - 1;
+	auto idx        = home(key);
+	while(used[idx] && slots[idx].first != key)
+		idx = (idx + 1) & mask;
+	return idx;
+}
+
+template <class V>
+void git2pp::oid_map<V>::rehash(std::size_t capacity) {
+	std::vector<value_type> old_slots(capacity);
+	std::vector<unsigned char> old_used(capacity);
+	old_slots.swap(slots);
+	old_used.swap(used);
+
+	for(std::size_t i = 0; i < old_slots.size(); ++i)
+		if(old_used[i]) {
+			const auto idx = probe(old_slots[i].first);
+			slots[idx]     = std::move(old_slots[i]);
+			used[idx]      = true;
+		}
+}
@@ -0,0 +1,63 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "oid.hpp"
+#include <cstddef>
+#include <vector>
+
+
+namespace git2pp {
+	// Sorted, deduplicated OIDs in one contiguous array; best filled in bulk through the constructor or insert_many()
+	class oid_set {
+	public:
+		using const_iterator = std::vector<oid>::const_iterator;
+
+
+		bool contains(const oid & id) const noexcept;
+		// First element not less than id, so a prefix's matches start here
+		const_iterator lower_bound(const oid & id) const noexcept;
+
+		// O(size()) each, prefer insert_many() for more than a handful
+		bool insert(const oid & id);
+		void insert_many(std::vector<oid> ids);
+		bool erase(const oid & id);
+
+		std::size_t size() const noexcept;
+		bool empty() const noexcept;
+		void clear() noexcept;
+		void reserve(std::size_t count);
+
+		const_iterator begin() const noexcept;
+		const_iterator end() const noexcept;
+		const oid & operator[](std::size_t idx) const noexcept;
+
+		oid_set() noexcept = default;
+		oid_set(std::vector<oid> ids);
+
+	private:
+		std::vector<oid> ids;
+	};
+}
@@ -0,0 +1,102 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "guard.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <git2/pack.h>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+namespace git2pp {
+	class repository;
+	class revwalk;
+
+	class pack_builder_deleter {
+	public:
+		void operator()(git_packbuilder * pb) const noexcept;
+	};
+
+
+	enum class pack_builder_stage : int {
+		adding_objects = GIT_PACKBUILDER_ADDING_OBJECTS,
+		deltafication  = GIT_PACKBUILDER_DELTAFICATION,
+	};
+
+
+	class pack_builder : public guard {
+	public:
+		using progress_callback = std::function<void(pack_builder_stage stage, std::uint32_t current, std::uint32_t total)>;
+
+
+		bool insert(const git_oid & id, const char * name = nullptr) noexcept;
+		bool insert(const git_oid & id, const std::string & name) noexcept;
+		bool insert_tree(const git_oid & id) noexcept;
+		bool insert_commit(const git_oid & id) noexcept;
+		bool insert_recursive(const git_oid & id, const char * name = nullptr) noexcept;
+		bool insert_recursive(const git_oid & id, const std::string & name) noexcept;
+		// Every commit reachable from tips but not from hidden, with their trees and blobs
+		bool insert_walk(const std::vector<git_oid> & tips, const std::vector<git_oid> & hidden = {}) noexcept;
+		// Consumes the walk
+		bool insert_walk(revwalk & walk) noexcept;
+
+		// 0 uses every online CPU for the delta search, which is also the default
+		unsigned int threads(unsigned int count) noexcept;
+		void progress(progress_callback func);
+
+		// nullptr/empty path writes into the repository's objects/pack/
+		bool write(const char * path = nullptr, unsigned int mode = 0) noexcept;
+		bool write(const std::string & path, unsigned int mode = 0) noexcept;
+		// F is called with consecutive (const void * data, std::size_t size) chunks of the pack and returns false to abort
+		template <class F>
+		bool stream(F && func) noexcept;
+
+		// Only meaningful after the pack has been written or streamed
+		git_oid hash() const noexcept;
+		std::size_t object_count() const noexcept;
+		std::size_t written() const noexcept;
+
+		pack_builder(repository & repo) noexcept;
+
+	private:
+		std::unique_ptr<git_packbuilder, pack_builder_deleter> pb;
+		git_repository * repo;
+		// Heap-allocated so the address handed to libgit2 survives moves
+		std::unique_ptr<progress_callback> progress_func;
+	};
+}
+
+
+template <class F>
+bool git2pp::pack_builder::stream(F && func) noexcept {
+	return !git_packbuilder_foreach(pb.get(),
+	                                [](void * data, std::size_t size, void * payload) -> int { return !(*static_cast<std::remove_reference_t<F> *>(payload))(data, size); },
+	                                &func);
+}
@@ -0,0 +1,70 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "guard.hpp"
+#include "odb.hpp"
+#include <cstddef>
+#include <experimental/optional>
+#include <functional>
+#include <git2/indexer.h>
+#include <memory>
+#include <string>
+
+
+namespace git2pp {
+	class repository;
+
+	class pack_indexer_deleter {
+	public:
+		void operator()(git_indexer * idx) const noexcept;
+	};
+
+
+	// Feed a pack in chunks of any size as it arrives; objects are indexed while the rest is still being received
+	class pack_indexer : public guard {
+	public:
+		using progress_callback = std::function<void(const git_transfer_progress & stats)>;
+
+
+		bool append(const void * data, std::size_t size) noexcept;
+		bool append(const std::string & data) noexcept;
+		// Resolves deltas, writes the .idx and moves the pack into place, returning its checksum
+		std::experimental::optional<git_oid> commit() noexcept;
+
+		const git_transfer_progress & stats() const noexcept;
+
+		// nullptr/empty path indexes into the repository's objects/pack/
+		pack_indexer(repository & repo, const char * path = nullptr, unsigned int mode = 0, progress_callback progress = {});
+		pack_indexer(repository & repo, const std::string & path, unsigned int mode = 0, progress_callback progress = {});
+
+	private:
+		// Heap-allocated so the address handed to libgit2 survives moves
+		std::unique_ptr<progress_callback> progress_func;
+		std::unique_ptr<git_odb, odb_deleter> db;
+		std::unique_ptr<git_indexer, pack_indexer_deleter> idx;
+		git_transfer_progress progress_stats;
+	};
+}
@@ -0,0 +1,91 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "guard.hpp"
+#include "oid.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <experimental/optional>
+#include <git2/oid.h>
+#include <git2/types.h>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace git2pp {
+	class commit_tree;
+	class repository;
+
+	// Every path (and every directory leading to one) mapped to the commits reachable from a tip that changed it, kept on disk between runs.
+	// A commit changed a path if its entry there differs from the one in every parent, so merges only count for what they changed themselves.
+	// Commits are numbered in topological order as they're indexed. The last commit to change a path is the highest-numbered one that left it
+	// as the tip has it, so a merge taking one side's version answers with that side's change even if the other side was numbered after it
+	class path_index : public guard {
+	public:
+		// Indexes the commits reachable from tip but not from the last one indexed, split across threads; 0 threads means one per core.
+		// If tip doesn't descend from the last one, history's been rewritten and everything's indexed again.
+		// The index is left as it was on failure
+		bool update(const git_oid & tip, std::size_t threads = 0);
+		// Writes the index back to where it was loaded from
+		bool save() const;
+
+		const std::experimental::optional<git_oid> & tip() const noexcept;
+		// Commits indexed
+		std::size_t size() const noexcept;
+
+		// Slash-separated, relative to the root; newest first
+		std::vector<git_oid> history(const std::string & path) const;
+		std::experimental::optional<git_oid> last_commit(const std::string & path) const;
+		// Last commit to have changed each entry of tree, which is at dir ("" for the root), to what it is there, in entry order.
+		// One lookup per entry, absent for those the index doesn't know
+		std::vector<std::experimental::optional<git_oid>> last_modified(const commit_tree & tree, const std::string & dir) const;
+
+		// Loads what was saved at path, if anything: a missing or damaged file gives an empty index. repo has to outlive the index
+		path_index(repository & repo, std::string path);
+		// At the repository's path-index
+		path_index(repository & repo);
+
+	private:
+		struct change {
+			std::uint32_t commit;
+			// Leading bytes of what the path pointed to after the commit, 0 if it was removed
+			std::uint64_t entry;
+		};
+
+		void load();
+		void truncate(std::uint32_t commits);
+		// Highest-numbered change that left the path at entry, the highest overall if none did
+		static std::uint32_t last_change(const std::vector<change> & changes, const git_oid & entry) noexcept;
+
+		git_repository * repo;
+		std::string file_path;
+		std::experimental::optional<git_oid> indexed_tip;
+		std::vector<oid> ids;
+		// By commit number, ascending
+		std::map<std::string, std::vector<change>> paths;
+	};
+}
@@ -33,6 +33,7 @@
 #include "detail/types.hpp"
 #include "guard.hpp"
 #include "object.hpp"
+#include "odb.hpp"
 #include "reference.hpp"
 #include <experimental/optional>
 #include <git2/repository.h>
@@ -98,6 +99,8 @@ namespace git2pp {
 		configuration config() noexcept;
 		configuration config_snapshot() noexcept;
 
+		odb object_database() noexcept;
+
 		std::string message();
 		void remove_message() noexcept;
 
@@ -110,6 +113,9 @@ namespace git2pp {
 
 		git_oid hash_file(const char * path, object_type type, const char * filters = nullptr) noexcept;
 		git_oid hash_file(const std::string & path, object_type type, std::experimental::optional<std::string> filters = std::experimental::nullopt) noexcept;
+		// Hashed in parallel, each extra thread on its own handle; IDs are in input order, zeroed for paths that couldn't be hashed.
+		// 0 threads means one per core
+		std::vector<git_oid> hash_files(const std::vector<std::string> & paths, object_type type, const char * filters = nullptr, std::size_t threads = 0);
 
 		void set_head(const char * refname) noexcept;
 		void set_head(const std::string & refname) noexcept;
@@ -217,6 +223,17 @@ namespace git2pp {
 		git_oid commit_create(const git_signature & author, const git_signature & committer, const std::string & message, const commit_tree & tree,
 		                      const char * update_ref, const char * message_encoding, const T &... parents);
 
+		std::experimental::optional<git_oid> merge_base(const git_oid & one, const git_oid & two) noexcept;
+		std::vector<git_oid> merge_bases(const git_oid & one, const git_oid & two);
+		std::experimental::optional<git_oid> merge_base_many(const std::vector<git_oid> & ids) noexcept;
+		std::vector<git_oid> merge_bases_many(const std::vector<git_oid> & ids);
+		std::experimental::optional<git_oid> merge_base_octopus(const std::vector<git_oid> & ids) noexcept;
+
+		// {ahead, behind}: commits reachable from local but not from upstream, and the other way around.
+		// For many branches against one base see commit_graph::ahead_behind()
+		std::experimental::optional<std::pair<std::size_t, std::size_t>> ahead_behind(const git_oid & local, const git_oid & upstream) noexcept;
+		bool descendant_of(const git_oid & descendant, const git_oid & ancestor) noexcept;
+
 		commit_tree tree_lookup(const git_oid & id) noexcept;
 		commit_tree tree_lookup(const git_oid & id, std::size_t prefix_len) noexcept;
 
@@ -232,6 +249,9 @@ namespace git2pp {
 		git_oid blob_create_from_disk(const char * path) noexcept;
 		git_oid blob_create_from_disk(const std::string & path) noexcept;
 
+		blob_writer blob_create_from_stream(const char * hint_path = nullptr) noexcept;
+		blob_writer blob_create_from_stream(const std::string & hint_path) noexcept;
+
 		template <class F>
 		git_oid blob_create_from_chunks(F && func) noexcept;
 		template <class F>
@@ -248,9 +268,21 @@ namespace git2pp {
 		friend class commit_tree_builder;
 		friend class commit_tree_entry;
 		friend class annotated_commit;
+		friend class repository_pool;
+		friend class history_table;
+		friend class abbrev_index;
+		friend class file_history;
+		friend class lookup_cache;
+		friend class commit_graph;
+		friend class pack_indexer;
+		friend class pack_builder;
 		friend class commit_tree;
 		friend class transaction;
+		friend class fast_import;
+		friend class path_index;
 		friend class reference;
+		friend class revwalk;
+		friend class mempack;
 		friend class object;
 		friend class commit;
 		friend class blob;
@@ -319,10 +351,17 @@ git_oid git2pp::repository::blob_create_from_chunks(F && func) noexcept {
 
 template <class F>
 git_oid git2pp::repository::blob_create_from_chunks(F && func, const char * hint_path) noexcept {
-	git_oid id;
-	git_blob_create_fromchunks(&id, repo.get(), hint_path,
-	                           [](char * data, std::size_t size, void * payload) -> int { return (*static_cast<F *>(payload))(data, size); }, &func);
-	return id;
+	auto writer = blob_create_from_stream(hint_path);
+
+	char chunk[8192];
+	int read;
+	while((read = func(chunk, sizeof(chunk))) > 0)
+		if(!writer.write(chunk, read))
+			return {};
+	if(read < 0)
+		return {};
+
+	return writer.commit().value_or(git_oid{});
 }
 
 template <class F>
@@ -0,0 +1,109 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "guard.hpp"
+#include "odb.hpp"
+#include "repository.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace git2pp {
+	// Every handle shares the pool's object database, which libgit2 locks internally;
+	// a handle itself is only ever used by whoever holds its lease
+	class repository_pool : public guard {
+	public:
+		class lease {
+		public:
+			repository & operator*() noexcept;
+			repository * operator->() noexcept;
+
+			lease(lease && other) noexcept;
+			~lease();
+
+		private:
+			friend class repository_pool;
+
+			lease(repository_pool & pool, repository && repo) noexcept;
+
+			repository_pool * pool;
+			repository repo;
+		};
+
+
+		// Blocks while capacity() handles are leased out; the lease holds a null handle if one couldn't be opened
+		lease acquire();
+
+		// False if the repository couldn't be opened, in which case acquire() never blocks
+		bool valid() const noexcept;
+		std::size_t size();
+		std::size_t capacity() const noexcept;
+
+		// Results keep pointing into pooled handles, so they mustn't outlive the pool; 0 threads means capacity().
+		// The calling thread looks up the first slice; the rest go to worker threads the pool keeps from the first call that needs them on
+		std::vector<object> lookup_many(const std::vector<git_oid> & ids, object_type type, std::size_t threads = 0);
+		std::vector<commit> commit_lookup_many(const std::vector<git_oid> & ids, std::size_t threads = 0);
+		std::vector<commit_tree> tree_lookup_many(const std::vector<git_oid> & ids, std::size_t threads = 0);
+		std::vector<blob> blob_lookup_many(const std::vector<git_oid> & ids, std::size_t threads = 0);
+
+		// 0 capacity means no limit
+		repository_pool(const char * path, std::size_t capacity = std::thread::hardware_concurrency());
+		repository_pool(const std::string & path, std::size_t capacity = std::thread::hardware_concurrency());
+		~repository_pool();
+
+	private:
+		repository open() noexcept;
+		void release(repository && repo);
+		// Calls func(slice) for every slice in [0, slices), 0 on the calling thread, and rethrows the first exception once they're all done
+		void dispatch(std::size_t slices, const std::function<void(std::size_t)> & func);
+		void work();
+
+		template <class T, class R, class F>
+		std::vector<T> lookup_many_raw(const std::vector<git_oid> & ids, std::size_t threads, F && lookup);
+
+		std::string path;
+		std::size_t max_handles;
+		std::unique_ptr<git_odb, odb_deleter> odb;
+
+		std::mutex idle_mutex;
+		std::condition_variable idle_available;
+		std::vector<repository> idle;
+		std::size_t opened;
+
+		std::mutex work_mutex;
+		std::condition_variable work_available;
+		std::deque<std::function<void()>> tasks;
+		std::vector<std::thread> workers;
+		bool stopping;
+	};
+}
@@ -0,0 +1,130 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "guard.hpp"
+#include <cstddef>
+#include <experimental/optional>
+#include <git2/revwalk.h>
+#include <iterator>
+#include <memory>
+#include <string>
+
+
+namespace git2pp {
+	class repository;
+
+	enum class revwalk_sort : unsigned int {
+		none        = GIT_SORT_NONE,
+		topological = GIT_SORT_TOPOLOGICAL,
+		time        = GIT_SORT_TIME,
+		reverse     = GIT_SORT_REVERSE,
+	};
+
+	constexpr revwalk_sort operator&(revwalk_sort lhs, revwalk_sort rhs) noexcept;
+	constexpr revwalk_sort operator|(revwalk_sort lhs, revwalk_sort rhs) noexcept;
+
+
+	class revwalk_deleter {
+	public:
+		void operator()(git_revwalk * walk) const noexcept;
+	};
+
+
+	// Commits are produced one at a time as they're asked for, so stopping early never walks the rest of history.
+	// Running out resets the walk, which then has to be pushed again; sorting and first-parent simplification stay
+	class revwalk : public guard {
+	public:
+		class iterator {
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type        = git_oid;
+			using difference_type   = std::ptrdiff_t;
+			using pointer           = const git_oid *;
+			using reference         = const git_oid &;
+
+			reference operator*() const noexcept;
+			pointer operator->() const noexcept;
+			iterator & operator++() noexcept;
+			iterator operator++(int) noexcept;
+
+			bool operator==(const iterator & other) const noexcept;
+			bool operator!=(const iterator & other) const noexcept;
+
+		private:
+			friend class revwalk;
+
+			iterator(revwalk * walk) noexcept;
+
+			revwalk * walk;
+			git_oid current;
+		};
+
+
+		bool push(const git_oid & id) noexcept;
+		bool push_ref(const char * refname) noexcept;
+		bool push_ref(const std::string & refname) noexcept;
+		bool push_glob(const char * glob) noexcept;
+		bool push_glob(const std::string & glob) noexcept;
+		bool push_head() noexcept;
+		// "a..b" pushes b and hides a, "a...b" pushes the commits reachable from either but not both
+		bool push_range(const char * range) noexcept;
+		bool push_range(const std::string & range) noexcept;
+
+		bool hide(const git_oid & id) noexcept;
+		bool hide_ref(const char * refname) noexcept;
+		bool hide_ref(const std::string & refname) noexcept;
+		bool hide_glob(const char * glob) noexcept;
+		bool hide_glob(const std::string & glob) noexcept;
+		bool hide_head() noexcept;
+
+		// Resets the walk
+		void sorting(revwalk_sort mode) noexcept;
+		void simplify_first_parent() noexcept;
+		void reset() noexcept;
+
+		std::experimental::optional<git_oid> next() noexcept;
+
+		// Input range: begin() pulls the first commit and there's only a single pass
+		iterator begin() noexcept;
+		iterator end() noexcept;
+
+		revwalk(repository & repo) noexcept;
+
+	private:
+		friend class pack_builder;
+
+		std::unique_ptr<git_revwalk, revwalk_deleter> walk;
+	};
+}
+
+
+constexpr git2pp::revwalk_sort git2pp::operator&(git2pp::revwalk_sort lhs, git2pp::revwalk_sort rhs) noexcept {
+	return static_cast<revwalk_sort>(static_cast<unsigned int>(lhs) & static_cast<unsigned int>(rhs));
+}
+
+constexpr git2pp::revwalk_sort git2pp::operator|(git2pp::revwalk_sort lhs, git2pp::revwalk_sort rhs) noexcept {
+	return static_cast<revwalk_sort>(static_cast<unsigned int>(lhs) | static_cast<unsigned int>(rhs));
+}
@@ -0,0 +1,63 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include "guard.hpp"
+#include "object.hpp"
+#include <cstddef>
+#include <git2/common.h>
+#include <git2/version.h>
+
+
+namespace git2pp {
+	// libgit2 drops these back to defaults when it's shut down, so keep a runtime alive for them to stick
+	class runtime_options : public guard {
+	public:
+		struct cached_memory_t {
+			std::ptrdiff_t current;
+			std::ptrdiff_t allowed;
+		};
+
+
+		std::size_t mwindow_size() const noexcept;
+		void mwindow_size(std::size_t size) noexcept;
+		std::size_t mwindow_mapped_limit() const noexcept;
+		void mwindow_mapped_limit(std::size_t limit) noexcept;
+#if LIBGIT2_VER_MAJOR > 1 || (LIBGIT2_VER_MAJOR == 1 && LIBGIT2_VER_MINOR >= 1)
+		std::size_t mwindow_file_limit() const noexcept;
+		void mwindow_file_limit(std::size_t limit) noexcept;
+#endif
+#if LIBGIT2_VER_MAJOR > 0 || LIBGIT2_VER_MINOR >= 28
+		std::size_t pack_max_objects() const noexcept;
+		void pack_max_objects(std::size_t objects) noexcept;
+#endif
+
+		void caching(bool enabled) noexcept;
+		void cache_object_limit(object_type type, std::size_t size) noexcept;
+		std::ptrdiff_t cache_max_size() const noexcept;
+		void cache_max_size(std::ptrdiff_t size) noexcept;
+		cached_memory_t cached_memory() const noexcept;
+	};
+}
@@ -0,0 +1,92 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <experimental/optional>
+#include <experimental/string_view>
+#include <git2/types.h>
+#include <memory>
+#include <vector>
+
+
+namespace git2pp {
+	class signature;
+
+	// Every distinct (name, email) pair stored once, NUL-terminated, in an arena of large blocks, and named by a 32-bit handle.
+	// Handles are dense from 0, so they index side tables directly, and equal handles mean equal identities.
+	// Views and signatures handed out stay valid until clear(), interning never moves what's already there
+	class signature_pool {
+	public:
+		using handle = std::uint32_t;
+
+
+		handle intern(std::experimental::string_view name, std::experimental::string_view email);
+		handle intern(const git_signature & sig);
+		handle intern(const signature & sig);
+		// "Name <email> 1234567890 +0000", as in a raw commit header; the time is ignored
+		handle intern_raw(std::experimental::string_view sig);
+
+		std::experimental::optional<handle> find(std::experimental::string_view name, std::experimental::string_view email) const noexcept;
+
+		std::experimental::string_view name(handle hndl) const noexcept;
+		std::experimental::string_view email(handle hndl) const noexcept;
+		// Name and email point into the pool
+		git_signature to_signature(handle hndl, git_time when = {}) const noexcept;
+
+		// Interns everything in other; the result maps other's handles to this pool's
+		std::vector<handle> merge(const signature_pool & other);
+
+		std::size_t size() const noexcept;
+		// Arena bytes in use, not counting the handle table
+		std::size_t arena_size() const noexcept;
+		void clear() noexcept;
+
+		signature_pool();
+
+	private:
+		struct entry {
+			const char * name;
+			std::uint32_t name_size;
+			std::uint32_t email_size;
+			std::size_t hash;
+		};
+
+		static std::size_t hash_of(std::experimental::string_view name, std::experimental::string_view email) noexcept;
+
+		// Slot holding the pair or the empty one it'd go in
+		std::size_t probe(std::experimental::string_view name, std::experimental::string_view email, std::size_t hash) const noexcept;
+		void rehash(std::size_t capacity);
+		char * allocate(std::size_t size);
+
+		std::vector<entry> entries;
+		std::vector<handle> slots;
+		std::vector<std::unique_ptr<char[]>> blocks;
+		char * block_free;
+		std::size_t block_left;
+		std::size_t used_bytes;
+	};
+}
@@ -0,0 +1,134 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/abbrev_index.hpp"
+#include "libgit2++/odb.hpp"
+#include "libgit2++/repository.hpp"
+#include <algorithm>
+#include <iterator>
+
+
+static std::size_t common_digits(const git2pp::oid & lhs, const git2pp::oid & rhs) noexcept;
+
+
+std::experimental::optional<git2pp::oid> git2pp::abbrev_index::resolve_prefix(std::experimental::string_view hex) const noexcept {
+	if(hex.empty() || hex.size() > oid::hex_size)
+		return std::experimental::nullopt;
+
+	git_oid prefix{};
+	for(std::size_t i = 0; i < hex.size(); ++i) {
+		const auto value = detail::hex_value(hex[i]);
+		if(value < 0)
+			return std::experimental::nullopt;
+		prefix.id[i / 2] |= static_cast<unsigned char>(i % 2 ? value : value << 4);
+	}
+
+	const oid low(prefix);
+	const auto itr = ids.lower_bound(low);
+	if(itr == ids.end() || common_digits(*itr, low) < hex.size())
+		return std::experimental::nullopt;
+	if(std::next(itr) != ids.end() && common_digits(*std::next(itr), low) >= hex.size())
+		return std::experimental::nullopt;
+	return *itr;
+}
+
+std::vector<std::experimental::optional<git2pp::oid>> git2pp::abbrev_index::resolve_prefixes(const std::vector<std::experimental::string_view> & hexes) const {
+	std::vector<std::experimental::optional<oid>> result;
+	result.reserve(hexes.size());
+	std::transform(hexes.begin(), hexes.end(), std::back_inserter(result), [&](auto && hex) { return this->resolve_prefix(hex); });
+	return result;
+}
+
+std::size_t git2pp::abbrev_index::shortest_unique_abbrev(const oid & id, std::size_t min_len) const noexcept {
+	// Only the sorted neighbours can share a longer prefix than anything else
+	const auto itr   = ids.lower_bound(id);
+	const auto after = (itr != ids.end() && *itr == id) ? std::next(itr) : itr;
+
+	std::size_t shared = 0;
+	if(after != ids.end())
+		shared = common_digits(*after, id);
+	if(itr != ids.begin())
+		shared = std::max(shared, common_digits(*std::prev(itr), id));
+
+	return std::min(std::max(shared + 1, min_len), oid::hex_size);
+}
+
+std::vector<std::size_t> git2pp::abbrev_index::shortest_unique_abbrevs(const std::vector<oid> & ids, std::size_t min_len) const {
+	std::vector<std::size_t> result;
+	result.reserve(ids.size());
+	std::transform(ids.begin(), ids.end(), std::back_inserter(result), [&](auto && id) { return this->shortest_unique_abbrev(id, min_len); });
+	return result;
+}
+
+std::string git2pp::abbrev_index::abbreviate(const oid & id, std::size_t min_len) const {
+	return id.str().substr(0, shortest_unique_abbrev(id, min_len));
+}
+
+std::size_t git2pp::abbrev_index::size() const noexcept {
+	return ids.size();
+}
+
+void git2pp::abbrev_index::insert(const oid & id) {
+	ids.insert(id);
+}
+
+void git2pp::abbrev_index::insert_many(std::vector<oid> added) {
+	ids.insert_many(std::move(added));
+}
+
+bool git2pp::abbrev_index::refresh() noexcept {
+	git_odb * db{};
+	if(git_repository_odb(&db, repo))
+		return false;
+	const std::unique_ptr<git_odb, odb_deleter> db_ptr(db);
+
+	std::vector<oid> found;
+	if(git_odb_foreach(db,
+	                   [](const git_oid * id, void * payload) {
+		                   try {
+			                   static_cast<std::vector<oid> *>(payload)->emplace_back(*id);
+			                   return 0;
+		                   } catch(...) {
+			                   return -1;
+		                   }
+		                 },
+	                   &found))
+		return false;
+
+	// The same object can be in a pack and loose, or in several packs
+	ids = oid_set(std::move(found));
+	return true;
+}
+
+
+git2pp::abbrev_index::abbrev_index(repository & r) noexcept : repo(r.repo.get()) {
+	refresh();
+}
+
+
+static std::size_t common_digits(const git2pp::oid & lhs, const git2pp::oid & rhs) noexcept {
+	for(std::size_t i = 0; i < git2pp::oid::size; ++i)
+		if(lhs.data()[i] != rhs.data()[i])
+			return i * 2 + ((lhs.data()[i] >> 4) == (rhs.data()[i] >> 4));
+	return git2pp::oid::hex_size;
+}
@@ -22,8 +22,8 @@
 
 
 #include "libgit2++/blob.hpp"
-#include "libgit2++/detail/scope.hpp"
 #include "libgit2++/repository.hpp"
+#include <git2/filter.h>
 
 
 void git2pp::blob_deleter::operator()(git_blob * blb) const noexcept {
@@ -31,6 +31,14 @@ void git2pp::blob_deleter::operator()(git_blob * blb) const noexcept {
 		git_blob_free(blb);
 }
 
+void git2pp::blob_writer_deleter::operator()(git_writestream * stream) const noexcept {
+	stream->free(stream);
+}
+
+
+bool git2pp::blob::valid() const noexcept {
+	return blb != nullptr;
+}
 
 bool git2pp::blob::binary() const noexcept {
 	return git_blob_is_binary(blb.get());
@@ -48,18 +56,68 @@ std::pair<const void *, std::uint64_t> git2pp::blob::raw() const noexcept {
 	return {git_blob_rawcontent(blb.get()), git_blob_rawsize(blb.get())};
 }
 
-std::string git2pp::blob::filtered(const char * as_path, bool check_for_binary_data) {
-	git_buf buf{};
-	detail::quickscope_wrapper buf_cleanup{[&]() { git_buf_free(&buf); }};
-
-	git_blob_filtered_content(&buf, blb.get(), as_path, check_for_binary_data);
+std::experimental::string_view git2pp::blob::content() const noexcept {
+	return {static_cast<const char *>(git_blob_rawcontent(blb.get())), static_cast<std::size_t>(git_blob_rawsize(blb.get()))};
+}
 
-	return {buf.ptr, buf.size};
+std::string git2pp::blob::filtered(const char * as_path, bool check_for_binary_data) {
+	buffer buf;
+	filtered_into(buf, as_path, check_for_binary_data);
+	return buf.str();
 }
 
 std::string git2pp::blob::filtered(const std::string & as_path, bool check_for_binary_data) {
 	return filtered(as_path.c_str(), check_for_binary_data);
 }
 
+bool git2pp::blob::filtered_into(buffer & out, const char * as_path, bool check_for_binary_data) {
+	// Same as git_blob_filtered_content(), except that without filters libgit2 would free out and have it borrow the content instead
+	out.buf.size = 0;
+	if(out.buf.asize)
+		out.buf.ptr[0] = '\0';
+	if(check_for_binary_data && binary())
+		return true;
+
+	git_filter_list * filters{};
+	if(git_filter_list_load(&filters, git_blob_owner(blb.get()), blb.get(), as_path, GIT_FILTER_TO_WORKTREE, GIT_FILTER_DEFAULT))
+		return false;
+	if(!filters) {
+		const auto data = content();
+		return !git_buf_set(&out.buf, data.data(), data.size());
+	}
+
+	const auto result = git_filter_list_apply_to_blob(&out.buf, filters, blb.get());
+	git_filter_list_free(filters);
+	return !result;
+}
+
+bool git2pp::blob::filtered_into(buffer & out, const std::string & as_path, bool check_for_binary_data) {
+	return filtered_into(out, as_path.c_str(), check_for_binary_data);
+}
+
 
 git2pp::blob::blob(git_blob * blb, bool owning) noexcept : blb(blb, {owning}) {}
+
+
+bool git2pp::blob_writer::write(const void * data, std::size_t size) noexcept {
+	return stream && !stream->write(stream.get(), static_cast<const char *>(data), size);
+}
+
+bool git2pp::blob_writer::write(const std::string & data) noexcept {
+	return write(data.data(), data.size());
+}
+
+std::experimental::optional<git_oid> git2pp::blob_writer::commit() noexcept {
+	if(!stream)
+		return std::experimental::nullopt;
+
+	// Frees the stream regardless of the outcome
+	git_oid id;
+	if(git_blob_create_fromstream_commit(&id, stream.release()))
+		return std::experimental::nullopt;
+	else
+		return id;
+}
+
+
+git2pp::blob_writer::blob_writer(git_writestream * stream) noexcept : stream(stream) {}
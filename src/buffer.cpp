@@ -0,0 +1,70 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/buffer.hpp"
+#include <utility>
+
+
+const char * git2pp::buffer::data() const noexcept {
+	return buf.ptr;
+}
+
+std::size_t git2pp::buffer::size() const noexcept {
+	return buf.size;
+}
+
+std::size_t git2pp::buffer::capacity() const noexcept {
+	return buf.asize;
+}
+
+bool git2pp::buffer::empty() const noexcept {
+	return !buf.size;
+}
+
+std::experimental::string_view git2pp::buffer::view() const noexcept {
+	return {buf.ptr, buf.size};
+}
+
+std::string git2pp::buffer::str() const {
+	return {buf.ptr, buf.size};
+}
+
+bool git2pp::buffer::reserve(std::size_t size) noexcept {
+	return !git_buf_grow(&buf, size);
+}
+
+
+git2pp::buffer::buffer() noexcept : buf{} {}
+
+git2pp::buffer::buffer(buffer && other) noexcept : guard(other), buf(other.buf) {
+	other.buf = {};
+}
+
+git2pp::buffer::~buffer() {
+	git_buf_free(&buf);
+}
+
+git2pp::buffer & git2pp::buffer::operator=(buffer && other) noexcept {
+	std::swap(buf, other.buf);
+	return *this;
+}
@@ -37,6 +37,10 @@ void git2pp::annotated_commit_deleter::operator()(git_annotated_commit * cmt) co
 }
 
 
+bool git2pp::commit::valid() const noexcept {
+	return cmt != nullptr;
+}
+
 const git_oid & git2pp::commit::id() const noexcept {
 	return *git_commit_id(cmt.get());
 }
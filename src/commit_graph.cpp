@@ -0,0 +1,810 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/commit_graph.hpp"
+#include "libgit2++/commit_view.hpp"
+#include "libgit2++/detail/parallel.hpp"
+#include "libgit2++/detail/scope.hpp"
+#include "libgit2++/detail/sha1.hpp"
+#include "libgit2++/detail/tree_diff.hpp"
+#include "libgit2++/oid.hpp"
+#include "libgit2++/oid_map.hpp"
+#include "libgit2++/odb.hpp"
+#include "libgit2++/repository.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <git2/refs.h>
+#include <numeric>
+#include <unordered_set>
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+constexpr std::uint32_t git2pp::commit_graph::generation_max;
+
+
+static const std::size_t header_size      = 8;
+static const std::size_t chunk_entry_size = 12;
+static const std::size_t fanout_size      = 256 * 4;
+static const std::size_t commit_data_size = GIT_OID_RAWSZ + 16;
+
+static const std::uint32_t chunk_oid_fanout   = 0x4F494446;  // "OIDF"
+static const std::uint32_t chunk_oid_lookup   = 0x4F49444C;  // "OIDL"
+static const std::uint32_t chunk_commit_data  = 0x43444154;  // "CDAT"
+static const std::uint32_t chunk_extra_edges  = 0x45444745;  // "EDGE"
+static const std::uint32_t chunk_bloom_index  = 0x42494458;  // "BIDX"
+static const std::uint32_t chunk_bloom_data   = 0x42444154;  // "BDAT"
+static const std::uint32_t parent_none        = 0x70000000;
+static const std::uint32_t parent_extra_edges = 0x80000000;
+static const std::uint32_t parent_last        = 0x80000000;
+static const std::int64_t time_max            = (std::int64_t{1} << 34) - 1;
+
+// Git's defaults, which it also expects when reading
+static const std::size_t bloom_header_size        = 12;
+static const std::uint32_t bloom_version          = 1;
+static const std::uint32_t bloom_hash_count       = 7;
+static const std::uint32_t bloom_bits_per_entry   = 10;
+static const std::size_t bloom_max_changed_paths  = 512;
+static const std::uint32_t bloom_seeds[2]         = {0x293ae76f, 0x7e646e2c};
+
+
+namespace {
+	struct parsed_commit {
+		git_oid tree;
+		std::vector<git_oid> parents;
+		std::int64_t time;
+	};
+}
+
+static std::uint32_t read_be32(const unsigned char * data) noexcept;
+static std::uint64_t read_be64(const unsigned char * data) noexcept;
+static void append_be32(std::string & out, std::uint32_t value);
+static void append_be64(std::string & out, std::uint64_t value);
+static std::vector<git_oid> reference_tips(git_repository * repo);
+static unsigned int lowest_bit(std::uint64_t bits) noexcept;
+static std::uint32_t murmur3(std::uint32_t seed, std::experimental::string_view data) noexcept;
+static void bloom_add(unsigned char * filter, std::size_t size, std::experimental::string_view path) noexcept;
+static bool bloom_contains(const unsigned char * filter, std::size_t size, std::uint32_t hashes, std::experimental::string_view path) noexcept;
+
+
+bool git2pp::commit_graph::write(repository & repo, std::size_t threads, bool changed_paths) {
+	return write(repo, reference_tips(repo.repo.get()), std::string(git_repository_path(repo.repo.get())) + "objects/info/commit-graph", threads,
+	             changed_paths);
+}
+
+bool git2pp::commit_graph::write(repository & repo, const std::vector<git_oid> & tips, const std::string & path, std::size_t threads, bool changed_paths) {
+	git_odb * db_raw{};
+	if(git_repository_odb(&db_raw, repo.repo.get()))
+		return false;
+	const std::unique_ptr<git_odb, odb_deleter> db(db_raw);
+
+
+	// Index of every commit seen so far; each frontier is read in parallel, then its unseen parents form the next one
+	oid_map<std::uint32_t> index;
+	std::vector<oid> commit_ids;
+	std::vector<parsed_commit> commits;
+	std::vector<std::uint32_t> frontier;
+	const auto see = [&](const git_oid & id, std::vector<std::uint32_t> & into) {
+		if(index.insert(id, static_cast<std::uint32_t>(commit_ids.size())).second) {
+			into.emplace_back(static_cast<std::uint32_t>(commit_ids.size()));
+			commit_ids.emplace_back(id);
+			commits.emplace_back();
+		}
+	};
+
+	for(auto && tip : tips)
+		see(tip, frontier);
+
+	while(!frontier.empty()) {
+		std::atomic<bool> failed{false};
+		detail::parallel_for(frontier.size(), detail::thread_count(frontier.size(), threads, 64), [&](auto, auto begin, auto end) {
+			for(auto i = begin; i != end && !failed; ++i) {
+				const auto idx = frontier[i];
+				git_odb_object * obj{};
+				if(git_odb_read(&obj, db.get(), &static_cast<const git_oid &>(commit_ids[idx]))) {
+					failed = true;
+					break;
+				}
+				detail::quickscope_wrapper obj_cleanup{[&]() { git_odb_object_free(obj); }};
+
+				const commit_view view(static_cast<const char *>(git_odb_object_data(obj)), git_odb_object_size(obj));
+				if(git_odb_object_type(obj) != GIT_OBJ_COMMIT || !view.valid()) {
+					failed = true;
+					break;
+				}
+
+				auto & commit         = commits[idx];
+				const auto parent_ids = view.parent_ids();
+				commit.tree           = view.tree_id();
+				commit.parents.assign(parent_ids.begin(), parent_ids.end());
+				commit.time = view.time();
+			}
+		});
+		if(failed)
+			return false;
+
+		std::vector<std::uint32_t> next;
+		for(auto idx : frontier)
+			for(auto && parent : commits[idx].parents)
+				see(parent, next);
+		frontier = std::move(next);
+	}
+
+	if(commits.size() >= parent_none)
+		return false;
+
+
+	std::vector<std::uint32_t> order(commits.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&](auto lhs, auto rhs) { return commit_ids[lhs] < commit_ids[rhs]; });
+	std::vector<std::uint32_t> positions(commits.size());
+	for(std::uint32_t pos = 0; pos < order.size(); ++pos)
+		positions[order[pos]] = pos;
+
+	// Post-order over the parents so every generation is known before its children need it
+	std::vector<std::uint32_t> generations(commits.size());
+	std::vector<std::uint32_t> stack;
+	for(std::uint32_t start = 0; start < commits.size(); ++start) {
+		if(generations[start])
+			continue;
+
+		stack.emplace_back(start);
+		while(!stack.empty()) {
+			const auto idx = stack.back();
+			if(generations[idx]) {
+				stack.pop_back();
+				continue;
+			}
+
+			std::uint32_t highest = 0;
+			bool ready            = true;
+			for(auto && parent : commits[idx].parents) {
+				const auto parent_idx = *index.find(parent);
+				if(!generations[parent_idx]) {
+					stack.emplace_back(parent_idx);
+					ready = false;
+				} else
+					highest = std::max(highest, generations[parent_idx]);
+			}
+
+			if(ready) {
+				generations[idx] = std::min(highest + 1, generation_max);
+				stack.pop_back();
+			}
+		}
+	}
+
+
+	// Each slice of positions gets its filters in a run of its own, the runs go in back to back
+	std::string bloom_index, bloom_data;
+	if(changed_paths) {
+		const auto slice_threads = detail::thread_count(order.size(), threads, 64);
+		std::vector<std::string> slice_filters(slice_threads);
+		std::vector<std::vector<std::uint32_t>> slice_sizes(slice_threads);
+		std::atomic<bool> failed{false};
+		detail::parallel_for(order.size(), slice_threads, [&](auto idx, auto begin, auto end) {
+			auto & filters = slice_filters[idx];
+			auto & sizes   = slice_sizes[idx];
+			for(auto pos = begin; pos != end && !failed; ++pos) {
+				const auto & cmt = commits[order[pos]];
+				const auto paths = detail::changed_paths(db.get(), cmt.parents.empty() ? nullptr : &commits[*index.find(cmt.parents[0])].tree, &cmt.tree,
+				                                         bloom_max_changed_paths);
+				if(!paths) {
+					failed = true;
+					break;
+				}
+
+				// Too many changes get a filter that matches everything, none at all one that matches nothing
+				const auto size = paths->size() > bloom_max_changed_paths ? 1 : std::max<std::size_t>((paths->size() * bloom_bits_per_entry + 7) / 8, 1);
+				const auto at   = filters.size();
+				filters.append(size, paths->size() > bloom_max_changed_paths ? '\xFF' : '\0');
+				if(paths->size() <= bloom_max_changed_paths)
+					for(auto && changed : *paths)
+						bloom_add(reinterpret_cast<unsigned char *>(&filters[at]), size, changed);
+				sizes.emplace_back(static_cast<std::uint32_t>(size));
+			}
+		});
+		if(failed)
+			return false;
+
+		std::uint32_t filters_end = 0;
+		append_be32(bloom_data, bloom_version);
+		append_be32(bloom_data, bloom_hash_count);
+		append_be32(bloom_data, bloom_bits_per_entry);
+		for(std::size_t i = 0; i < slice_threads; ++i) {
+			for(auto size : slice_sizes[i])
+				append_be32(bloom_index, filters_end += size);
+			bloom_data += slice_filters[i];
+		}
+	}
+
+
+	std::string oid_lookup, commit_data, extra_edges;
+	std::uint32_t fanout[256]{};
+	oid_lookup.reserve(commits.size() * GIT_OID_RAWSZ);
+	commit_data.reserve(commits.size() * commit_data_size);
+	for(auto idx : order) {
+		const auto & id  = commit_ids[idx];
+		const auto & cmt = commits[idx];
+		++fanout[id.data()[0]];
+		oid_lookup.append(reinterpret_cast<const char *>(id.data()), GIT_OID_RAWSZ);
+
+		commit_data.append(reinterpret_cast<const char *>(cmt.tree.id), GIT_OID_RAWSZ);
+		const auto parent_pos = [&](std::size_t n) { return positions[*index.find(cmt.parents[n])]; };
+		append_be32(commit_data, cmt.parents.empty() ? parent_none : parent_pos(0));
+		if(cmt.parents.size() <= 1)
+			append_be32(commit_data, parent_none);
+		else if(cmt.parents.size() == 2)
+			append_be32(commit_data, parent_pos(1));
+		else {
+			append_be32(commit_data, parent_extra_edges | static_cast<std::uint32_t>(extra_edges.size() / 4));
+			for(std::size_t n = 1; n < cmt.parents.size(); ++n)
+				append_be32(extra_edges, parent_pos(n) | (n + 1 == cmt.parents.size() ? parent_last : 0));
+		}
+
+		const auto time = static_cast<std::uint64_t>(std::min(std::max(cmt.time, std::int64_t{0}), time_max));
+		append_be64(commit_data, (static_cast<std::uint64_t>(generations[idx]) << 34) | time);
+	}
+	for(std::size_t i = 1; i < 256; ++i)
+		fanout[i] += fanout[i - 1];
+
+
+	std::vector<std::pair<std::uint32_t, const std::string *>> chunks{{chunk_oid_fanout, nullptr}, {chunk_oid_lookup, &oid_lookup}, {chunk_commit_data, &commit_data}};
+	if(!extra_edges.empty())
+		chunks.emplace_back(chunk_extra_edges, &extra_edges);
+	if(changed_paths) {
+		chunks.emplace_back(chunk_bloom_index, &bloom_index);
+		chunks.emplace_back(chunk_bloom_data, &bloom_data);
+	}
+
+	std::string contents("CGPH\x01\x01", 6);
+	contents.push_back(static_cast<char>(chunks.size()));
+	contents.push_back('\0');
+
+	std::uint64_t offset = header_size + (chunks.size() + 1) * chunk_entry_size;
+	for(auto && chunk : chunks) {
+		append_be32(contents, chunk.first);
+		append_be64(contents, offset);
+		offset += chunk.second ? chunk.second->size() : fanout_size;
+	}
+	append_be32(contents, 0);
+	append_be64(contents, offset);
+
+	for(auto count : fanout)
+		append_be32(contents, count);
+	for(auto && chunk : chunks)
+		if(chunk.second)
+			contents += *chunk.second;
+
+	detail::sha1 checksum;
+	checksum.update(contents.data(), contents.size());
+	const auto trailer = checksum.finish();
+	contents.append(reinterpret_cast<const char *>(trailer.id), GIT_OID_RAWSZ);
+
+
+	// Readers only ever see a complete file
+	const auto lock_path = path + ".lock";
+	{
+		std::ofstream out(lock_path, std::ios::binary | std::ios::trunc);
+		if(!out.write(contents.data(), contents.size()) || !out.flush())
+			return false;
+	}
+#ifdef _WIN32
+	std::remove(path.c_str());
+#endif
+	return !std::rename(lock_path.c_str(), path.c_str());
+}
+
+bool git2pp::commit_graph::valid() const noexcept {
+	return static_cast<bool>(file);
+}
+
+bool git2pp::commit_graph::verify() const noexcept {
+	if(!valid())
+		return false;
+
+	detail::sha1 checksum;
+	checksum.update(file.get(), file_size - GIT_OID_RAWSZ);
+	const auto expected = checksum.finish();
+	return !std::memcmp(expected.id, file.get() + file_size - GIT_OID_RAWSZ, GIT_OID_RAWSZ);
+}
+
+std::uint32_t git2pp::commit_graph::size() const noexcept {
+	return count;
+}
+
+std::experimental::optional<std::uint32_t> git2pp::commit_graph::position(const git_oid & id) const noexcept {
+	const auto first = id.id[0] ? read_be32(fanout + (id.id[0] - 1) * 4) : 0;
+	const auto last  = read_be32(fanout + id.id[0] * 4);
+
+	const auto itr = std::lower_bound(ids + first, ids + last, id, [](auto && lhs, auto && rhs) { return git_oid_cmp(&lhs, &rhs) < 0; });
+	if(itr == ids + last || git_oid_cmp(itr, &id))
+		return std::experimental::nullopt;
+	else
+		return static_cast<std::uint32_t>(itr - ids);
+}
+
+const git_oid & git2pp::commit_graph::id(std::uint32_t pos) const noexcept {
+	return ids[pos];
+}
+
+const git_oid & git2pp::commit_graph::tree_id(std::uint32_t pos) const noexcept {
+	return *reinterpret_cast<const git_oid *>(commit_data + pos * commit_data_size);
+}
+
+std::int64_t git2pp::commit_graph::time(std::uint32_t pos) const noexcept {
+	return static_cast<std::int64_t>(read_be64(commit_data + pos * commit_data_size + GIT_OID_RAWSZ + 8) & time_max);
+}
+
+std::uint32_t git2pp::commit_graph::generation(std::uint32_t pos) const noexcept {
+	return read_be32(commit_data + pos * commit_data_size + GIT_OID_RAWSZ + 8) >> 2;
+}
+
+std::uint32_t git2pp::commit_graph::parent_count(std::uint32_t pos) const noexcept {
+	const auto data = commit_data + pos * commit_data_size + GIT_OID_RAWSZ;
+	if(read_be32(data) == parent_none)
+		return 0;
+
+	const auto second = read_be32(data + 4);
+	if(second == parent_none)
+		return 1;
+	if(!(second & parent_extra_edges))
+		return 2;
+
+	std::uint32_t amount = 1;
+	for(auto edge = second & ~parent_extra_edges; edge < extra_edges_count; ++edge) {
+		++amount;
+		if(read_be32(extra_edges + edge * 4) & parent_last)
+			break;
+	}
+	return amount;
+}
+
+std::uint32_t git2pp::commit_graph::parent(std::uint32_t pos, std::uint32_t n) const noexcept {
+	const auto data = commit_data + pos * commit_data_size + GIT_OID_RAWSZ;
+	if(!n)
+		return read_be32(data);
+
+	const auto second = read_be32(data + 4);
+	if(!(second & parent_extra_edges))
+		return second;
+	return read_be32(extra_edges + ((second & ~parent_extra_edges) + n - 1) * 4) & ~parent_last;
+}
+
+std::vector<std::uint32_t> git2pp::commit_graph::parents(std::uint32_t pos) const {
+	std::vector<std::uint32_t> result;
+	for_each_parent(pos, [&](auto parent) { result.emplace_back(parent); });
+	return result;
+}
+
+bool git2pp::commit_graph::has_changed_paths() const noexcept {
+	return bloom_index;
+}
+
+bool git2pp::commit_graph::maybe_changed(std::uint32_t pos, std::experimental::string_view path) const noexcept {
+	if(!bloom_index)
+		return true;
+
+	const auto begin = pos ? read_be32(bloom_index + (pos - 1) * 4) : 0;
+	const auto end   = read_be32(bloom_index + pos * 4);
+	if(begin >= end || end > bloom_data_size)
+		return true;
+
+	// Git puts every leading directory of a changed path in too, so each has to be there
+	const auto filter = bloom_data + begin;
+	while(!path.empty() && path.back() == '/')
+		path.remove_suffix(1);
+	while(!path.empty()) {
+		if(!bloom_contains(filter, end - begin, bloom_hashes, path))
+			return false;
+		const auto slash = path.rfind('/');
+		path             = path.substr(0, slash == std::experimental::string_view::npos ? 0 : slash);
+	}
+	return true;
+}
+
+bool git2pp::commit_graph::is_ancestor(std::uint32_t ancestor, std::uint32_t descendant) const {
+	if(ancestor == descendant)
+		return true;
+
+	// Anything at or under the ancestor's generation can't reach it, unless the numbers have saturated
+	const auto target = generation(ancestor);
+	const auto prune  = target != generation_max;
+	if(prune && generation(descendant) <= target)
+		return false;
+
+	// Pruning usually stops the walk long before it sees much of the graph, so only what it does see is kept
+	std::unordered_set<std::uint32_t> seen{descendant};
+	std::vector<std::uint32_t> stack{descendant};
+	while(!stack.empty()) {
+		const auto pos = stack.back();
+		stack.pop_back();
+
+		const auto parents = parent_count(pos);
+		for(std::uint32_t i = 0; i < parents; ++i) {
+			const auto par = parent(pos, i);
+			if(par == ancestor)
+				return true;
+			if((!prune || generation(par) > target) && seen.insert(par).second)
+				stack.emplace_back(par);
+		}
+	}
+	return false;
+}
+
+bool git2pp::commit_graph::is_ancestor(const git_oid & ancestor, const git_oid & descendant) const {
+	const auto ancestor_pos   = position(ancestor);
+	const auto descendant_pos = position(descendant);
+	return ancestor_pos && descendant_pos && is_ancestor(*ancestor_pos, *descendant_pos);
+}
+
+std::vector<git2pp::commit_graph_ahead_behind> git2pp::commit_graph::ahead_behind(std::uint32_t base, const std::vector<std::uint32_t> & tips,
+                                                                                  std::size_t threads) const {
+	// Bit 0 of a commit's mask is the base, bit n+1 the walk's nth tip
+	static const std::size_t tips_per_walk = 63;
+
+	std::vector<commit_graph_ahead_behind> result(tips.size());
+	if(tips.empty())
+		return result;
+
+	const auto walks = (tips.size() + tips_per_walk - 1) / tips_per_walk;
+	detail::parallel_for(walks, detail::thread_count(walks, threads), [&](auto, auto begin, auto end) {
+		std::vector<std::uint64_t> masks(count);
+		std::vector<std::uint32_t> touched;
+		std::vector<std::uint32_t> queue;
+		const auto by_generation = [&](auto lhs, auto rhs) { return generation(lhs) < generation(rhs); };
+
+		for(auto walk = begin; walk != end; ++walk) {
+			const auto first     = walk * tips_per_walk;
+			const auto walk_tips = std::min(tips_per_walk, tips.size() - first);
+			const auto all       = ~std::uint64_t{0} >> (63 - walk_tips);
+
+			// Once every queued commit is reachable from everything and every tip has its merge base, nothing left can change the counts
+			auto unresolved     = all & ~std::uint64_t{1};
+			std::size_t partial = 0;
+			const auto mark     = [&](std::uint32_t pos, std::uint64_t bits) {
+				auto & mask = masks[pos];
+				if(!mask) {
+					touched.emplace_back(pos);
+					queue.emplace_back(pos);
+					std::push_heap(queue.begin(), queue.end(), by_generation);
+					partial += bits != all;
+				} else if(mask != all && (mask | bits) == all)
+					--partial;
+				mask |= bits;
+			};
+
+			mark(base, 1);
+			for(std::size_t i = 0; i < walk_tips; ++i)
+				mark(tips[first + i], std::uint64_t{1} << (i + 1));
+
+			// Parents always have lower generations, so a commit's mask is final once it's at the top
+			while(!queue.empty() && (partial || unresolved)) {
+				std::pop_heap(queue.begin(), queue.end(), by_generation);
+				const auto pos = queue.back();
+				queue.pop_back();
+
+				const auto mask = masks[pos];
+				partial -= mask != all;
+
+				if(mask & 1) {
+					for(auto behind = all & ~mask; behind; behind &= behind - 1)
+						++result[first + lowest_bit(behind) - 1].behind;
+					for(auto common = mask & unresolved; common; common &= common - 1)
+						result[first + lowest_bit(common) - 1].merge_base = pos;
+					unresolved &= ~mask;
+				} else
+					for(auto ahead = mask; ahead; ahead &= ahead - 1)
+						++result[first + lowest_bit(ahead) - 1].ahead;
+
+				for_each_parent(pos, [&](auto parent) { mark(parent, mask); });
+			}
+
+			for(auto pos : touched)
+				masks[pos] = 0;
+			touched.clear();
+			queue.clear();
+		}
+	});
+	return result;
+}
+
+git2pp::commit_graph_ahead_behind git2pp::commit_graph::ahead_behind(std::uint32_t base, std::uint32_t tip) const {
+	return ahead_behind(base, std::vector<std::uint32_t>{tip}, 1).front();
+}
+
+std::vector<std::experimental::optional<git2pp::commit_graph_ahead_behind>> git2pp::commit_graph::ahead_behind(const git_oid & base, const std::vector<git_oid> & tips,
+                                                                                                               std::size_t threads) const {
+	std::vector<std::experimental::optional<commit_graph_ahead_behind>> result(tips.size());
+	const auto base_pos = position(base);
+	if(!base_pos)
+		return result;
+
+	std::vector<std::uint32_t> found;
+	std::vector<std::size_t> found_idx;
+	for(std::size_t i = 0; i < tips.size(); ++i)
+		if(const auto pos = position(tips[i])) {
+			found.emplace_back(*pos);
+			found_idx.emplace_back(i);
+		}
+
+	auto counts = ahead_behind(*base_pos, found, threads);
+	for(std::size_t i = 0; i < counts.size(); ++i)
+		result[found_idx[i]] = counts[i];
+	return result;
+}
+
+
+git2pp::commit_graph::commit_graph(repository & repo) : commit_graph(std::string(git_repository_path(repo.repo.get())) + "objects/info/commit-graph") {}
+
+git2pp::commit_graph::commit_graph(const char * path) : commit_graph(std::string(path)) {}
+
+git2pp::commit_graph::commit_graph(const std::string & path)
+      : file_size(0), fanout(nullptr), ids(nullptr), commit_data(nullptr), extra_edges(nullptr), extra_edges_count(0), bloom_index(nullptr), bloom_data(nullptr),
+        bloom_data_size(0), bloom_hashes(0), count(0) {
+#ifdef _WIN32
+	std::ifstream in(path, std::ios::binary);
+	if(!in)
+		return;
+	const std::vector<char> contents(std::istreambuf_iterator<char>(in), {});
+
+	const auto data = new unsigned char[contents.size()];
+	std::memcpy(data, contents.data(), contents.size());
+	file.reset(data, std::default_delete<unsigned char[]>());
+	file_size = contents.size();
+#else
+	const auto fd = open(path.c_str(), O_RDONLY);
+	if(fd < 0)
+		return;
+	detail::quickscope_wrapper fd_cleanup{[&]() { close(fd); }};
+
+	struct stat info;
+	if(fstat(fd, &info) || !info.st_size)
+		return;
+
+	const auto size = static_cast<std::size_t>(info.st_size);
+	const auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if(data == MAP_FAILED)
+		return;
+	file.reset(static_cast<const unsigned char *>(data), [size](auto ptr) { munmap(const_cast<unsigned char *>(ptr), size); });
+	file_size = size;
+#endif
+
+	load();
+}
+
+
+void git2pp::commit_graph::load() noexcept {
+	const auto data = file.get();
+	const auto fail = [&]() {
+		file.reset();
+		file_size   = 0;
+		count       = 0;
+		bloom_index = nullptr;
+	};
+
+	// Split graphs (a nonzero base graph count) chain onto other files, and their parent positions count from the first of those
+	if(file_size < header_size + chunk_entry_size + GIT_OID_RAWSZ || std::memcmp(data, "CGPH\x01\x01", 6) || data[7])
+		return fail();
+
+	const std::size_t chunks = data[6];
+	if(file_size < header_size + (chunks + 1) * chunk_entry_size + GIT_OID_RAWSZ)
+		return fail();
+
+	std::size_t oid_lookup_size{}, commit_data_bytes{}, extra_edges_size{}, bloom_index_size{};
+	for(std::size_t i = 0; i < chunks; ++i) {
+		const auto entry = data + header_size + i * chunk_entry_size;
+		const auto begin = read_be64(entry + 4);
+		const auto end   = read_be64(entry + chunk_entry_size + 4);
+		if(begin > end || end > file_size - GIT_OID_RAWSZ)
+			return fail();
+
+		switch(read_be32(entry)) {
+			case chunk_oid_fanout:
+				if(end - begin != fanout_size)
+					return fail();
+				fanout = data + begin;
+				break;
+			case chunk_oid_lookup:
+				ids             = reinterpret_cast<const git_oid *>(data + begin);
+				oid_lookup_size = end - begin;
+				break;
+			case chunk_commit_data:
+				commit_data       = data + begin;
+				commit_data_bytes = end - begin;
+				break;
+			case chunk_extra_edges:
+				extra_edges      = data + begin;
+				extra_edges_size = end - begin;
+				break;
+			case chunk_bloom_index:
+				bloom_index      = data + begin;
+				bloom_index_size = end - begin;
+				break;
+			case chunk_bloom_data:
+				bloom_data      = data + begin;
+				bloom_data_size = end - begin;
+				break;
+		}
+	}
+
+	if(!fanout || !ids || !commit_data)
+		return fail();
+	for(std::size_t i = 1; i < 256; ++i)
+		if(read_be32(fanout + i * 4) < read_be32(fanout + (i - 1) * 4))
+			return fail();
+
+	count = read_be32(fanout + 255 * 4);
+	if(oid_lookup_size != count * std::size_t{GIT_OID_RAWSZ} || commit_data_bytes != count * commit_data_size)
+		return fail();
+	extra_edges_count = extra_edges_size / 4;
+
+	// parent() follows these without checking, so every parent has to be in the graph and every run of extra edges has to end inside the chunk
+	const auto in_graph = [&](std::uint32_t pos) { return pos == parent_none || pos < count; };
+	if(extra_edges_count && !(read_be32(extra_edges + (extra_edges_count - 1) * 4) & parent_last))
+		return fail();
+	for(std::size_t i = 0; i < extra_edges_count; ++i)
+		if((read_be32(extra_edges + i * 4) & ~parent_last) >= count)
+			return fail();
+	for(std::uint32_t pos = 0; pos < count; ++pos) {
+		const auto parents = commit_data + pos * commit_data_size + GIT_OID_RAWSZ;
+		const auto second  = read_be32(parents + 4);
+		if(!in_graph(read_be32(parents)) || ((second & parent_extra_edges) ? (second & ~parent_extra_edges) >= extra_edges_count : !in_graph(second)))
+			return fail();
+	}
+
+	// Filters are optional, so ones we can't read are just ignored
+	if(bloom_index && bloom_data && bloom_index_size == count * std::size_t{4} && bloom_data_size >= bloom_header_size &&
+	   read_be32(bloom_data) == bloom_version && read_be32(bloom_data + 4)) {
+		bloom_hashes = read_be32(bloom_data + 4);
+		bloom_data += bloom_header_size;
+		bloom_data_size -= bloom_header_size;
+	} else {
+		bloom_index     = nullptr;
+		bloom_data      = nullptr;
+		bloom_data_size = 0;
+	}
+}
+
+
+static std::uint32_t read_be32(const unsigned char * data) noexcept {
+	return (static_cast<std::uint32_t>(data[0]) << 24) | (static_cast<std::uint32_t>(data[1]) << 16) | (static_cast<std::uint32_t>(data[2]) << 8) | data[3];
+}
+
+static std::uint64_t read_be64(const unsigned char * data) noexcept {
+	return (static_cast<std::uint64_t>(read_be32(data)) << 32) | read_be32(data + 4);
+}
+
+static void append_be32(std::string & out, std::uint32_t value) {
+	const char bytes[] = {static_cast<char>(value >> 24), static_cast<char>(value >> 16), static_cast<char>(value >> 8), static_cast<char>(value)};
+	out.append(bytes, sizeof(bytes));
+}
+
+static void append_be64(std::string & out, std::uint64_t value) {
+	append_be32(out, static_cast<std::uint32_t>(value >> 32));
+	append_be32(out, static_cast<std::uint32_t>(value));
+}
+
+static std::vector<git_oid> reference_tips(git_repository * repo) {
+	std::vector<std::string> names{"HEAD"};
+	git_reference_foreach_name(repo,
+	                           [](const char * name, void * payload) {
+		                           try {
+			                           static_cast<std::vector<std::string> *>(payload)->emplace_back(name);
+			                           return 0;
+		                           } catch(...) {
+			                           return -1;
+		                           }
+		                         },
+	                           &names);
+
+	std::vector<git_oid> tips;
+	for(auto && name : names) {
+		git_reference * ref{};
+		if(git_reference_lookup(&ref, repo, name.c_str()))
+			continue;
+		git2pp::detail::quickscope_wrapper ref_cleanup{[&]() { git_reference_free(ref); }};
+
+		// Refs to trees, blobs and tags of those are fine, they just don't contribute anything
+		git_object * target{};
+		if(git_reference_peel(&target, ref, GIT_OBJ_COMMIT))
+			continue;
+		tips.emplace_back(*git_object_id(target));
+		git_object_free(target);
+	}
+	return tips;
+}
+
+static unsigned int lowest_bit(std::uint64_t bits) noexcept {
+#ifdef __GNUC__
+	return __builtin_ctzll(bits);
+#else
+	unsigned int idx = 0;
+	for(; !(bits & 1); bits >>= 1)
+		++idx;
+	return idx;
+#endif
+}
+
+// Git's "version 1" murmur3, which sign-extends bytes past 0x7F wherever char is signed; every reader and writer has to do the same
+static std::uint32_t murmur3(std::uint32_t seed, std::experimental::string_view data) noexcept {
+	const auto byte   = [&](std::size_t idx) { return static_cast<std::uint32_t>(static_cast<std::int32_t>(static_cast<signed char>(data[idx]))); };
+	const auto rotate = [](std::uint32_t value, int by) { return (value << by) | (value >> (32 - by)); };
+	const auto mix    = [&](std::uint32_t k) { return rotate(k * 0xcc9e2d51, 15) * 0x1b873593; };
+
+	const auto blocks = data.size() / 4;
+	for(std::size_t i = 0; i < blocks; ++i) {
+		seed ^= mix(byte(i * 4) | (byte(i * 4 + 1) << 8) | (byte(i * 4 + 2) << 16) | (byte(i * 4 + 3) << 24));
+		seed = rotate(seed, 13) * 5 + 0xe6546b64;
+	}
+
+	std::uint32_t tail = 0;
+	switch(data.size() & 3) {
+		case 3:
+			tail ^= byte(blocks * 4 + 2) << 16;
+			// fallthrough
+		case 2:
+			tail ^= byte(blocks * 4 + 1) << 8;
+			// fallthrough
+		case 1:
+			tail ^= byte(blocks * 4);
+			seed ^= mix(tail);
+	}
+
+	seed ^= static_cast<std::uint32_t>(data.size());
+	seed ^= seed >> 16;
+	seed *= 0x85ebca6b;
+	seed ^= seed >> 13;
+	seed *= 0xc2b2ae35;
+	seed ^= seed >> 16;
+	return seed;
+}
+
+static void bloom_add(unsigned char * filter, std::size_t size, std::experimental::string_view path) noexcept {
+	const auto first = murmur3(bloom_seeds[0], path);
+	const auto step  = murmur3(bloom_seeds[1], path);
+	for(std::uint32_t i = 0; i < bloom_hash_count; ++i) {
+		const auto bit = (first + i * step) % (static_cast<std::uint64_t>(size) * 8);
+		filter[bit / 8] |= 1 << (bit % 8);
+	}
+}
+
+static bool bloom_contains(const unsigned char * filter, std::size_t size, std::uint32_t hashes, std::experimental::string_view path) noexcept {
+	const auto first = murmur3(bloom_seeds[0], path);
+	const auto step  = murmur3(bloom_seeds[1], path);
+	for(std::uint32_t i = 0; i < hashes; ++i) {
+		const auto bit = (first + i * step) % (static_cast<std::uint64_t>(size) * 8);
+		if(!(filter[bit / 8] & (1 << (bit % 8))))
+			return false;
+	}
+	return true;
+}
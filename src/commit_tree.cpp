@@ -42,6 +42,10 @@ void git2pp::commit_tree_builder_deleter::operator()(git_treebuilder * ent) cons
 }
 
 
+bool git2pp::commit_tree::valid() const noexcept {
+	return trr != nullptr;
+}
+
 const git_oid & git2pp::commit_tree::id() const noexcept {
 	return *git_tree_id(trr.get());
 }
@@ -127,7 +131,7 @@ git2pp::object git2pp::commit_tree_entry::to_object(git2pp::repository & repo) c
 	return {result};
 }
 
-git2pp::commit_tree_entry::commit_tree_entry(const commit_tree_entry & other) noexcept {
+git2pp::commit_tree_entry::commit_tree_entry(const commit_tree_entry & other) noexcept : guard(other) {
 	git_tree_entry * result;
 	git_tree_entry_dup(&result, other.ent.get());
 	ent = {result, {true}};
@@ -0,0 +1,195 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/commit_view.hpp"
+#include "libgit2++/oid.hpp"
+#include <cstring>
+
+
+constexpr std::size_t git2pp::commit_view::tree_line_size;
+constexpr std::size_t git2pp::commit_view::parent_line_size;
+
+
+git_oid git2pp::commit_view::parent_iterator::operator*() const noexcept {
+	return oid::from_hex({line + 7, GIT_OID_HEXSZ}).value_or(oid{});
+}
+
+git2pp::commit_view::parent_iterator & git2pp::commit_view::parent_iterator::operator++() noexcept {
+	line += parent_line_size;
+	if(static_cast<std::size_t>(end - line) < parent_line_size || std::memcmp(line, "parent ", 7) || line[parent_line_size - 1] != '\n')
+		line = end;
+	return *this;
+}
+
+git2pp::commit_view::parent_iterator git2pp::commit_view::parent_iterator::operator++(int) noexcept {
+	auto ret = *this;
+	++*this;
+	return ret;
+}
+
+bool git2pp::commit_view::parent_iterator::operator==(const parent_iterator & other) const noexcept {
+	return line == other.line;
+}
+
+bool git2pp::commit_view::parent_iterator::operator!=(const parent_iterator & other) const noexcept {
+	return !(*this == other);
+}
+
+git2pp::commit_view::parent_iterator::parent_iterator(const char * l, const char * e) noexcept : line(l), end(e) {}
+
+
+git2pp::commit_view::parent_iterator git2pp::commit_view::parent_range::begin() const noexcept {
+	return first;
+}
+
+git2pp::commit_view::parent_iterator git2pp::commit_view::parent_range::end() const noexcept {
+	return last;
+}
+
+
+bool git2pp::commit_view::valid() const noexcept {
+	return static_cast<std::size_t>(end - data) >= tree_line_size && !std::memcmp(data, "tree ", 5) && data[tree_line_size - 1] == '\n' &&
+	       oid::from_hex({data + 5, GIT_OID_HEXSZ});
+}
+
+std::experimental::string_view git2pp::commit_view::raw() const noexcept {
+	return {data, static_cast<std::size_t>(end - data)};
+}
+
+git_oid git2pp::commit_view::tree_id() const noexcept {
+	if(static_cast<std::size_t>(end - data) < tree_line_size)
+		return {};
+	return oid::from_hex({data + 5, GIT_OID_HEXSZ}).value_or(oid{});
+}
+
+git2pp::commit_view::parent_range git2pp::commit_view::parent_ids() const noexcept {
+	const auto last = fields();
+	const auto first = static_cast<std::size_t>(end - data) < tree_line_size ? last : data + tree_line_size;
+	return {{first, last}, {last, last}};
+}
+
+std::size_t git2pp::commit_view::parent_count() const noexcept {
+	if(static_cast<std::size_t>(end - data) < tree_line_size)
+		return 0;
+	return static_cast<std::size_t>(fields() - data - tree_line_size) / parent_line_size;
+}
+
+std::experimental::optional<git_oid> git2pp::commit_view::parent_id(std::size_t n) const noexcept {
+	if(n >= parent_count())
+		return {};
+	return *parent_iterator(data + tree_line_size + n * parent_line_size, end);
+}
+
+std::int64_t git2pp::commit_view::time() const noexcept {
+	std::experimental::string_view line;
+	auto cur = committer_time(line);
+	if(!cur)
+		return 0;
+
+	const auto last     = line.data() + line.size();
+	const auto negative = cur != last && *cur == '-';
+	cur += negative;
+	std::int64_t result = 0;
+	for(; cur != last && *cur >= '0' && *cur <= '9'; ++cur)
+		result = result * 10 + (*cur - '0');
+	return negative ? -result : result;
+}
+
+int git2pp::commit_view::time_offset() const noexcept {
+	std::experimental::string_view line;
+	auto cur = committer_time(line);
+	if(!cur)
+		return 0;
+
+	// "+hhmm" is the last thing on the line
+	const auto last = line.data() + line.size();
+	if(last - cur < 5 || (last[-5] != '+' && last[-5] != '-'))
+		return 0;
+	const auto digit   = [&](int idx) { return last[idx] - '0'; };
+	const auto minutes = (digit(-4) * 10 + digit(-3)) * 60 + digit(-2) * 10 + digit(-1);
+	return last[-5] == '-' ? -minutes : minutes;
+}
+
+std::experimental::string_view git2pp::commit_view::author() const noexcept {
+	return header("author");
+}
+
+std::experimental::string_view git2pp::commit_view::committer() const noexcept {
+	return header("committer");
+}
+
+std::experimental::string_view git2pp::commit_view::header(std::experimental::string_view name) const noexcept {
+	for(auto line = fields(); line != end && *line != '\n';) {
+		const auto last = line_end(line, end);
+		if(static_cast<std::size_t>(last - line) > name.size() && !std::memcmp(line, name.data(), name.size()) && line[name.size()] == ' ')
+			return {line + name.size() + 1, static_cast<std::size_t>(last - line) - name.size() - 1};
+		line = last + (last != end);
+	}
+	return {};
+}
+
+std::experimental::string_view git2pp::commit_view::message() const noexcept {
+	for(auto line = fields(); line != end;) {
+		if(*line == '\n')
+			return {line + 1, static_cast<std::size_t>(end - line - 1)};
+		const auto last = line_end(line, end);
+		line = last + (last != end);
+	}
+	return {};
+}
+
+git2pp::commit_view::commit_view(const char * d, std::size_t size) noexcept : data(d), end(d + size) {}
+
+git2pp::commit_view::commit_view(std::experimental::string_view r) noexcept : commit_view(r.data(), r.size()) {}
+
+git2pp::commit_view::commit_view(const odb_object & obj) noexcept : commit_view(static_cast<const char *>(obj.data()), obj.size()) {}
+
+const char * git2pp::commit_view::line_end(const char * line, const char * end) noexcept {
+	const auto found = static_cast<const char *>(std::memchr(line, '\n', end - line));
+	return found ? found : end;
+}
+
+const char * git2pp::commit_view::fields() const noexcept {
+	if(static_cast<std::size_t>(end - data) < tree_line_size)
+		return end;
+
+	auto line = data + tree_line_size;
+	while(static_cast<std::size_t>(end - line) >= parent_line_size && !std::memcmp(line, "parent ", 7) && line[parent_line_size - 1] == '\n')
+		line += parent_line_size;
+	return line;
+}
+
+const char * git2pp::commit_view::committer_time(std::experimental::string_view & line) const noexcept {
+	line = committer();
+	if(line.empty())
+		return nullptr;
+
+	// The time follows the last '>', whatever the name and email contain
+	const auto email_end = line.rfind('>');
+	if(email_end == std::experimental::string_view::npos)
+		return nullptr;
+	auto cur = line.data() + email_end + 1;
+	while(cur != line.data() + line.size() && *cur == ' ')
+		++cur;
+	return cur;
+}
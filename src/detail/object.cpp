@@ -22,6 +22,7 @@
 
 
 #include "libgit2++/object.hpp"
+#include "libgit2++/abbrev_index.hpp"
 #include "libgit2++/detail/scope.hpp"
 #include "libgit2++/repository.hpp"
 #include <git2/buffer.h>
@@ -61,6 +62,10 @@ git2pp::object git2pp::object::lookup_by_path(const std::string & path, object_t
 	return lookup_by_path(path.c_str(), type);
 }
 
+bool git2pp::object::valid() const noexcept {
+	return obj != nullptr;
+}
+
 const git_oid & git2pp::object::id() const noexcept {
 	return *git_object_id(obj.get());
 }
@@ -74,6 +79,10 @@ std::string git2pp::object::short_id() const {
 	return {buf.ptr, buf.size};
 }
 
+std::string git2pp::object::short_id(const abbrev_index & index) const {
+	return index.abbreviate(id());
+}
+
 git2pp::object_type git2pp::object::type() const noexcept {
 	return static_cast<object_type>(git_object_type(obj.get()));
 }
@@ -0,0 +1,113 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/detail/sha1.hpp"
+#include <algorithm>
+#include <cstring>
+
+
+static std::uint32_t rotl(std::uint32_t value, unsigned int by) noexcept {
+	return (value << by) | (value >> (32 - by));
+}
+
+
+void git2pp::detail::sha1::update(const void * data, std::size_t size) noexcept {
+	auto bytes    = static_cast<const unsigned char *>(data);
+	auto buffered = static_cast<std::size_t>(length % 64);
+	length += size;
+
+	if(buffered) {
+		const auto take = std::min<std::size_t>(64 - buffered, size);
+		std::memcpy(buffer + buffered, bytes, take);
+		bytes += take;
+		size -= take;
+		if(buffered + take < 64)
+			return;
+		block(buffer);
+	}
+
+	for(; size >= 64; bytes += 64, size -= 64)
+		block(bytes);
+	std::memcpy(buffer, bytes, size);
+}
+
+git_oid git2pp::detail::sha1::finish() noexcept {
+	const auto bits = length * 8;
+
+	static const unsigned char padding[64] = {0x80};
+	update(padding, 1 + (119 - length % 64) % 64);
+
+	unsigned char length_bytes[8];
+	for(auto i = 0; i < 8; ++i)
+		length_bytes[i] = static_cast<unsigned char>(bits >> (56 - i * 8));
+	update(length_bytes, sizeof(length_bytes));
+
+	git_oid result;
+	for(auto i = 0; i < 20; ++i)
+		result.id[i] = static_cast<unsigned char>(state[i / 4] >> (24 - (i % 4) * 8));
+	return result;
+}
+
+
+git2pp::detail::sha1::sha1() noexcept : state{0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0}, buffer{}, length(0) {}
+
+
+void git2pp::detail::sha1::block(const unsigned char * data) noexcept {
+	std::uint32_t words[80];
+	for(auto i = 0; i < 16; ++i)
+		words[i] = (static_cast<std::uint32_t>(data[i * 4]) << 24) | (static_cast<std::uint32_t>(data[i * 4 + 1]) << 16) |
+		           (static_cast<std::uint32_t>(data[i * 4 + 2]) << 8) | data[i * 4 + 3];
+	for(auto i = 16; i < 80; ++i)
+		words[i] = rotl(words[i - 3] ^ words[i - 8] ^ words[i - 14] ^ words[i - 16], 1);
+
+	auto a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+	for(auto i = 0; i < 80; ++i) {
+		std::uint32_t f, k;
+		if(i < 20) {
+			f = (b & c) | (~b & d);
+			k = 0x5A827999;
+		} else if(i < 40) {
+			f = b ^ c ^ d;
+			k = 0x6ED9EBA1;
+		} else if(i < 60) {
+			f = (b & c) | (b & d) | (c & d);
+			k = 0x8F1BBCDC;
+		} else {
+			f = b ^ c ^ d;
+			k = 0xCA62C1D6;
+		}
+
+		const auto next = rotl(a, 5) + f + e + k + words[i];
+		e               = d;
+		d               = c;
+		c               = rotl(b, 30);
+		b               = a;
+		a               = next;
+	}
+
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+}
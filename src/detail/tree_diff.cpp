@@ -0,0 +1,222 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/detail/tree_diff.hpp"
+#include "libgit2++/detail/scope.hpp"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+
+namespace {
+	struct raw_entry {
+		std::experimental::string_view name;
+		std::uint32_t mode;
+		const git_oid * id;
+	};
+
+	// Entries of a raw tree object, an empty one if constructed from null
+	class raw_tree {
+	public:
+		bool next(raw_entry & entry) noexcept;
+
+		bool read(git_odb * db, const git_oid * id) noexcept;
+
+		raw_tree() noexcept;
+		~raw_tree();
+
+	private:
+		git_odb_object * obj;
+		const char * cur;
+		const char * end;
+	};
+}
+
+
+static bool is_tree(const raw_entry & entry) noexcept;
+static int compare_entries(const raw_entry & lhs, const raw_entry & rhs) noexcept;
+static bool diff_trees(git_odb * db, const git_oid * old_tree, const git_oid * new_tree, std::string & prefix, std::size_t limit,
+                       std::vector<std::string> & out, std::vector<git_oid> * ids);
+
+
+std::experimental::optional<std::vector<std::string>> git2pp::detail::changed_paths(git_odb * db, const git_oid * old_tree, const git_oid * new_tree,
+                                                                                   std::size_t limit, std::vector<git_oid> * ids) {
+	std::vector<std::string> result;
+	std::string prefix;
+	if(ids)
+		ids->clear();
+	if(!diff_trees(db, old_tree, new_tree, prefix, limit ? limit : static_cast<std::size_t>(-1) - 1, result, ids))
+		return std::experimental::nullopt;
+	return result;
+}
+
+bool git2pp::detail::tree_entry_at(git_odb * db, const git_oid & tree, std::experimental::string_view path, git_oid & id, std::uint32_t & mode) {
+	const git_oid * current = &tree;
+	git_oid current_id;
+	while(!path.empty()) {
+		const auto slash     = path.find('/');
+		const auto component = path.substr(0, slash);
+		path                 = slash == std::experimental::string_view::npos ? std::experimental::string_view{} : path.substr(slash + 1);
+
+		raw_tree entries;
+		if(!entries.read(db, current))
+			return false;
+
+		raw_entry entry;
+		bool found = false;
+		while(!found && entries.next(entry))
+			found = entry.name == component;
+		if(!found)
+			return false;
+
+		if(path.empty()) {
+			id   = *entry.id;
+			mode = entry.mode;
+			return true;
+		}
+		if(!is_tree(entry))
+			return false;
+		current_id = *entry.id;
+		current    = &current_id;
+	}
+	return false;
+}
+
+
+bool raw_tree::next(raw_entry & entry) noexcept {
+	// "<octal mode> <name>\0<raw id>"
+	if(cur == end)
+		return false;
+
+	entry.mode = 0;
+	for(; cur != end && *cur >= '0' && *cur <= '7'; ++cur)
+		entry.mode = entry.mode * 8 + (*cur - '0');
+	if(cur == end || *cur != ' ')
+		return false;
+
+	const auto name     = ++cur;
+	const auto name_end = static_cast<const char *>(std::memchr(name, '\0', end - name));
+	if(!name_end || static_cast<std::size_t>(end - name_end - 1) < GIT_OID_RAWSZ)
+		return false;
+
+	entry.name = {name, static_cast<std::size_t>(name_end - name)};
+	entry.id   = reinterpret_cast<const git_oid *>(name_end + 1);
+	cur        = name_end + 1 + GIT_OID_RAWSZ;
+	return true;
+}
+
+bool raw_tree::read(git_odb * db, const git_oid * id) noexcept {
+	if(!id)
+		return true;
+	if(git_odb_read(&obj, db, id) || git_odb_object_type(obj) != GIT_OBJ_TREE)
+		return false;
+
+	cur = static_cast<const char *>(git_odb_object_data(obj));
+	end = cur + git_odb_object_size(obj);
+	return true;
+}
+
+raw_tree::raw_tree() noexcept : obj(nullptr), cur(nullptr), end(nullptr) {}
+
+raw_tree::~raw_tree() {
+	git_odb_object_free(obj);
+}
+
+
+static bool is_tree(const raw_entry & entry) noexcept {
+	return (entry.mode & 0170000) == 0040000;
+}
+
+// Git's tree order: names compare bytewise, with trees as if they ended in a slash
+static int compare_entries(const raw_entry & lhs, const raw_entry & rhs) noexcept {
+	const auto len = std::min(lhs.name.size(), rhs.name.size());
+	if(const auto cmp = std::memcmp(lhs.name.data(), rhs.name.data(), len))
+		return cmp;
+
+	const unsigned char lhs_next = lhs.name.size() > len ? lhs.name[len] : is_tree(lhs) ? '/' : '\0';
+	const unsigned char rhs_next = rhs.name.size() > len ? rhs.name[len] : is_tree(rhs) ? '/' : '\0';
+	return lhs_next < rhs_next ? -1 : lhs_next > rhs_next;
+}
+
+static bool diff_trees(git_odb * db, const git_oid * old_tree, const git_oid * new_tree, std::string & prefix, std::size_t limit,
+                       std::vector<std::string> & out, std::vector<git_oid> * ids) {
+	raw_tree old_entries, new_entries;
+	if(!old_entries.read(db, old_tree) || !new_entries.read(db, new_tree))
+		return false;
+
+	const auto level_start = out.size();
+	const auto changed     = [&](const raw_entry * old_entry, const raw_entry * new_entry) {
+		const auto & entry    = old_entry ? *old_entry : *new_entry;
+		const auto prefix_len = prefix.size();
+		prefix.append(entry.name.data(), entry.name.size());
+		git2pp::detail::quickscope_wrapper prefix_cleanup{[&]() { prefix.resize(prefix_len); }};
+
+		const git_oid gone{};
+		const auto & id = new_entry ? *new_entry->id : gone;
+		if(!is_tree(entry)) {
+			out.emplace_back(prefix);
+			if(ids)
+				ids->emplace_back(id);
+			return true;
+		}
+
+		// A file replaced by a directory of the same name has been counted already
+		const auto before = out.size();
+		prefix.push_back('/');
+		if(!diff_trees(db, old_entry ? old_entry->id : nullptr, new_entry ? new_entry->id : nullptr, prefix, limit, out, ids))
+			return false;
+		prefix.pop_back();
+		if(out.size() != before) {
+			const auto counted = std::find(out.begin() + level_start, out.begin() + before, prefix);
+			if(counted == out.begin() + before) {
+				out.emplace_back(prefix);
+				if(ids)
+					ids->emplace_back(id);
+			} else if(ids && new_entry)
+				(*ids)[counted - out.begin()] = id;
+		}
+		return true;
+	};
+
+	raw_entry old_entry, new_entry;
+	auto has_old = old_entries.next(old_entry);
+	auto has_new = new_entries.next(new_entry);
+	while((has_old || has_new) && out.size() <= limit) {
+		const auto cmp = !has_old ? 1 : !has_new ? -1 : compare_entries(old_entry, new_entry);
+		if(cmp < 0) {
+			if(!changed(&old_entry, nullptr))
+				return false;
+			has_old = old_entries.next(old_entry);
+		} else if(cmp > 0) {
+			if(!changed(nullptr, &new_entry))
+				return false;
+			has_new = new_entries.next(new_entry);
+		} else {
+			if((old_entry.mode != new_entry.mode || git_oid_cmp(old_entry.id, new_entry.id)) && !changed(&old_entry, &new_entry))
+				return false;
+			has_old = old_entries.next(old_entry);
+			has_new = new_entries.next(new_entry);
+		}
+	}
+	return true;
+}
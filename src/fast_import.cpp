@@ -0,0 +1,699 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/fast_import.hpp"
+#include "libgit2++/detail/scope.hpp"
+#include "libgit2++/oid.hpp"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <git2/commit.h>
+#include <git2/object.h>
+#include <git2/odb.h>
+#include <git2/refs.h>
+#include <git2/revparse.h>
+#include <git2/transaction.h>
+#include <git2/tree.h>
+
+
+// Also packed once this much data has piled up, however few objects it is
+static const std::size_t batch_bytes = std::size_t{256} << 20;
+static const std::uint32_t mode_tree = 0040000;
+
+
+struct git2pp::fast_import::tree_node {
+	struct entry {
+		std::uint32_t mode;
+		git_oid id;
+		// Only for trees that have been looked into
+		std::unique_ptr<tree_node> tree;
+	};
+
+	// Stale while dirty; a tree that's never been written has nothing to load
+	git_oid id;
+	bool loaded;
+	bool dirty;
+	std::map<std::string, entry> entries;
+
+	tree_node() : id{}, loaded(true), dirty(true) {}
+	tree_node(const git_oid & i) : id(i), loaded(false), dirty(false) {}
+};
+
+
+static void append_signature(std::string & out, const char * header, const git_signature & sig);
+static bool read_data(std::istream & in, const std::string & line, std::string & out);
+static bool parse_signature(const std::string & line, std::size_t from, std::string & name, std::string & email, git_signature & sig);
+static bool parse_mode(const std::string & mode, std::uint32_t & out) noexcept;
+static bool parse_path(const std::string & line, std::size_t & pos, bool to_space, std::string & out);
+
+
+git_oid git2pp::fast_import::blob(const void * data, std::size_t size) {
+	return write(data, size, GIT_OBJ_BLOB);
+}
+
+git_oid git2pp::fast_import::blob(const std::string & data) {
+	return blob(data.data(), data.size());
+}
+
+void git2pp::fast_import::file_modify(const std::string & path, const git_oid & id, filemode mode) {
+	changes.push_back({change::kind::modify, path, {}, id, static_cast<std::uint32_t>(mode)});
+}
+
+void git2pp::fast_import::file_delete(const std::string & path) {
+	changes.push_back({change::kind::remove, path, {}, {}, 0});
+}
+
+void git2pp::fast_import::file_rename(const std::string & from, const std::string & to) {
+	changes.push_back({change::kind::rename, to, from, {}, 0});
+}
+
+void git2pp::fast_import::file_copy(const std::string & from, const std::string & to) {
+	changes.push_back({change::kind::copy, to, from, {}, 0});
+}
+
+void git2pp::fast_import::file_delete_all() {
+	changes.push_back({change::kind::remove_all, {}, {}, {}, 0});
+}
+
+bool git2pp::fast_import::reset(const std::string & ref, const git_oid & from) {
+	auto & br = branches[ref];
+	if(!start_from(br, from)) {
+		failed = true;
+		return false;
+	}
+	br.updated = true;
+	return true;
+}
+
+void git2pp::fast_import::reset(const std::string & ref) {
+	auto & br = branches[ref];
+	br.tip    = {};
+	br.root.reset(new tree_node);
+	br.updated = true;
+}
+
+git_oid git2pp::fast_import::commit(const std::string & ref, const git_signature & author, const git_signature & committer, const std::string & message,
+                                    const std::vector<git_oid> & merges) {
+	if(failed)
+		return {};
+
+	auto & br = branch_for(ref);
+	if(failed)
+		return {};
+	for(auto && chg : changes)
+		if(!apply(*br.root, chg)) {
+			changes.clear();
+			failed = true;
+			return {};
+		}
+	changes.clear();
+
+	const auto tree = write_tree(*br.root);
+	if(!tree)
+		return {};
+
+	char hex[GIT_OID_HEXSZ + 1];
+	std::string contents("tree ");
+	contents.append(git_oid_tostr(hex, sizeof(hex), &*tree)).push_back('\n');
+	if(!git_oid_iszero(&br.tip))
+		contents.append("parent ").append(git_oid_tostr(hex, sizeof(hex), &br.tip)).push_back('\n');
+	for(auto && parent : merges)
+		contents.append("parent ").append(git_oid_tostr(hex, sizeof(hex), &parent)).push_back('\n');
+	append_signature(contents, "author ", author);
+	append_signature(contents, "committer ", committer);
+	contents.push_back('\n');
+	contents += message;
+
+	const auto id = write(contents.data(), contents.size(), GIT_OBJ_COMMIT);
+	if(!failed) {
+		br.tip     = id;
+		br.updated = true;
+	}
+	return id;
+}
+
+std::experimental::optional<git_oid> git2pp::fast_import::tip(const std::string & ref) const {
+	const auto itr = branches.find(ref);
+	if(itr == branches.end() || git_oid_iszero(&itr->second.tip))
+		return std::experimental::nullopt;
+	else
+		return itr->second.tip;
+}
+
+bool git2pp::fast_import::parse(std::istream & in) {
+	std::string line;
+	bool line_pending = false;
+	const auto next_line = [&]() {
+		if(line_pending) {
+			line_pending = false;
+			return true;
+		}
+		return static_cast<bool>(std::getline(in, line));
+	};
+	const auto starts_with = [&](const char * prefix) { return !line.compare(0, std::char_traits<char>::length(prefix), prefix); };
+	// Leaves any other line for next time
+	const auto next_starts_with = [&](const char * prefix) {
+		if(!next_line())
+			return false;
+		line_pending = !starts_with(prefix);
+		return !line_pending;
+	};
+
+	// Optional "mark :<n>" and "original-oid <id>", in that order
+	const auto read_mark = [&](std::experimental::optional<std::uintmax_t> & mark) {
+		if(next_starts_with("mark :")) {
+			char * end;
+			mark = std::strtoumax(line.c_str() + 6, &end, 10);
+			if(*end)
+				return false;
+		}
+		next_starts_with("original-oid ");
+		return true;
+	};
+	// A mark, a full ID, or anything git rev-parse takes, branches in this import before all else
+	const auto resolve = [&](const std::string & commitish, git_oid & out) {
+		if(commitish[0] == ':') {
+			const auto itr = marks.find(std::strtoumax(commitish.c_str() + 1, nullptr, 10));
+			if(itr == marks.end())
+				return false;
+			out = itr->second;
+			return true;
+		}
+		if(const auto id = oid::from_hex(commitish)) {
+			out = *id;
+			return true;
+		}
+		if(const auto id = tip(commitish)) {
+			out = *id;
+			return true;
+		}
+
+		git_object * obj{};
+		if(git_revparse_single(&obj, repo.repo.get(), commitish.c_str()))
+			return false;
+		out = *git_object_id(obj);
+		git_object_free(obj);
+		return true;
+	};
+
+
+	std::string data, message;
+	while(next_line()) {
+		if(line.empty() || line[0] == '#' || starts_with("progress "))
+			continue;
+
+		if(line == "blob") {
+			std::experimental::optional<std::uintmax_t> mark;
+			if(!read_mark(mark) || !next_line() || !read_data(in, line, data))
+				return false;
+
+			const auto id = blob(data);
+			if(failed)
+				return false;
+			if(mark)
+				marks[*mark] = id;
+		} else if(starts_with("commit ")) {
+			const auto ref = line.substr(7);
+			std::experimental::optional<std::uintmax_t> mark;
+			if(!read_mark(mark) || !next_line())
+				return false;
+
+			// The strings the signatures point into
+			std::string author_name, author_email, committer_name, committer_email;
+			git_signature author, committer;
+			bool has_author = false;
+			if(starts_with("author ")) {
+				if(!parse_signature(line, 7, author_name, author_email, author) || !next_line())
+					return false;
+				has_author = true;
+			}
+			if(!starts_with("committer ") || !parse_signature(line, 10, committer_name, committer_email, committer) || !next_line() ||
+			   !read_data(in, line, message))
+				return false;
+
+			git_oid parent;
+			if(next_starts_with("from ") && (!resolve(line.substr(5), parent) || !reset(ref, parent)))
+				return false;
+			std::vector<git_oid> merges;
+			while(next_starts_with("merge ")) {
+				merges.emplace_back();
+				if(!resolve(line.substr(6), merges.back()))
+					return false;
+			}
+
+			while(next_line()) {
+				std::size_t pos;
+				std::string path, to;
+				if(starts_with("M ")) {
+					const auto mode_end = line.find(' ', 2);
+					const auto ref_end  = mode_end == std::string::npos ? mode_end : line.find(' ', mode_end + 1);
+					std::uint32_t mode;
+					if(ref_end == std::string::npos || !parse_mode(line.substr(2, mode_end - 2), mode))
+						return false;
+					pos = ref_end + 1;
+					if(!parse_path(line, pos, false, path))
+						return false;
+
+					const auto dataref = line.substr(mode_end + 1, ref_end - mode_end - 1);
+					git_oid id;
+					if(dataref == "inline") {
+						if(!next_line() || !read_data(in, line, data))
+							return false;
+						id = blob(data);
+					} else if(!resolve(dataref, id))
+						return false;
+					file_modify(path, id, static_cast<filemode>(mode));
+				} else if(starts_with("D ")) {
+					pos = 2;
+					if(!parse_path(line, pos, false, path))
+						return false;
+					file_delete(path);
+				} else if(starts_with("R ") || starts_with("C ")) {
+					pos = 2;
+					if(!parse_path(line, pos, true, path) || pos >= line.size() || line[pos++] != ' ' || !parse_path(line, pos, false, to))
+						return false;
+					if(line[0] == 'R')
+						file_rename(path, to);
+					else
+						file_copy(path, to);
+				} else if(line == "deleteall")
+					file_delete_all();
+				else {
+					line_pending = !line.empty();
+					break;
+				}
+			}
+
+			const auto id = commit(ref, has_author ? author : committer, committer, message, merges);
+			if(failed)
+				return false;
+			if(mark)
+				marks[*mark] = id;
+		} else if(starts_with("reset ")) {
+			const auto ref = line.substr(6);
+			git_oid from;
+			if(!next_starts_with("from "))
+				reset(ref);
+			else if(!resolve(line.substr(5), from) || !reset(ref, from))
+				return false;
+		} else if(line == "checkpoint") {
+			if(!flush())
+				return false;
+		} else if(line == "done")
+			return true;
+		else
+			return false;
+	}
+	return !in.bad();
+}
+
+bool git2pp::fast_import::finish(bool force) {
+	if(failed || !flush())
+		return false;
+
+	git_transaction * tx{};
+	if(git_transaction_new(&tx, repo.repo.get()))
+		return false;
+	detail::quickscope_wrapper tx_cleanup{[&]() { git_transaction_free(tx); }};
+
+	for(auto && br : branches)
+		if(br.second.updated && !git_oid_iszero(&br.second.tip)) {
+			if(git_transaction_lock_ref(tx, br.first.c_str()))
+				return false;
+
+			// Locked, so what it points at now is what it'd be moved from
+			git_oid current;
+			if(!force && !git_reference_name_to_id(&current, repo.repo.get(), br.first.c_str()) && !git_oid_equal(&current, &br.second.tip) &&
+			   git_graph_descendant_of(repo.repo.get(), &br.second.tip, &current) != 1)
+				return false;
+
+			if(git_transaction_set_target(tx, br.first.c_str(), &br.second.tip, nullptr, "fast_import"))
+				return false;
+		}
+	if(git_transaction_commit(tx))
+		return false;
+
+	for(auto && br : branches)
+		br.second.updated = false;
+	return true;
+}
+
+
+git2pp::fast_import::fast_import(repository & r, std::size_t batch)
+      : repo(repository::open(git_repository_path(r.repo.get()))), pack(repo), batch_objects(batch), batched_objects(0), batched_bytes(0), failed(false) {
+	git_odb * db_raw{};
+	if(git_repository_odb(&db_raw, repo.repo.get()))
+		failed = true;
+	db.reset(db_raw);
+}
+
+git2pp::fast_import::~fast_import() = default;
+
+
+auto git2pp::fast_import::branch_for(const std::string & ref) -> branch & {
+	const auto itr = branches.find(ref);
+	if(itr != branches.end())
+		return itr->second;
+
+	// Anything that isn't a commit to start from (like a tag) just means starting over, so that's not a failure
+	auto & br = branches[ref];
+	git_oid existing;
+	if(git_reference_name_to_id(&existing, repo.repo.get(), ref.c_str()) || !start_from(br, existing)) {
+		br.tip = {};
+		br.root.reset(new tree_node);
+	}
+	br.updated = false;
+	return br;
+}
+
+bool git2pp::fast_import::start_from(branch & br, const git_oid & from) {
+	git_commit * cmt{};
+	if(git_commit_lookup(&cmt, repo.repo.get(), &from))
+		return false;
+	detail::quickscope_wrapper cmt_cleanup{[&]() { git_commit_free(cmt); }};
+
+	br.tip = from;
+	br.root.reset(new tree_node(*git_commit_tree_id(cmt)));
+	return true;
+}
+
+bool git2pp::fast_import::load(tree_node & node) {
+	if(node.loaded)
+		return true;
+
+	git_tree * tree{};
+	if(git_tree_lookup(&tree, repo.repo.get(), &node.id))
+		return false;
+	detail::quickscope_wrapper tree_cleanup{[&]() { git_tree_free(tree); }};
+
+	const auto count = git_tree_entrycount(tree);
+	for(std::size_t i = 0; i < count; ++i) {
+		const auto ent = git_tree_entry_byindex(tree, i);
+		node.entries.emplace(git_tree_entry_name(ent), tree_node::entry{static_cast<std::uint32_t>(git_tree_entry_filemode_raw(ent)), *git_tree_entry_id(ent), nullptr});
+	}
+	node.loaded = true;
+	return true;
+}
+
+bool git2pp::fast_import::descend(tree_node & root, const std::string & path, bool create, std::vector<tree_node *> & chain) {
+	chain.assign(1, &root);
+	for(std::size_t begin = 0, slash; (slash = path.find('/', begin)) != std::string::npos; begin = slash + 1) {
+		auto & node = *chain.back();
+		if(slash == begin || !load(node))
+			return false;
+
+		auto itr = node.entries.find(path.substr(begin, slash - begin));
+		if(itr == node.entries.end() || itr->second.mode != mode_tree) {
+			if(!create)
+				return false;
+			// Whatever was in the way makes room for the directory
+			auto & ent = node.entries[path.substr(begin, slash - begin)];
+			ent.mode   = mode_tree;
+			ent.id     = {};
+			ent.tree.reset(new tree_node);
+			chain.emplace_back(ent.tree.get());
+		} else {
+			if(!itr->second.tree)
+				itr->second.tree.reset(new tree_node(itr->second.id));
+			chain.emplace_back(itr->second.tree.get());
+		}
+	}
+	return load(*chain.back());
+}
+
+bool git2pp::fast_import::apply(tree_node & root, const change & chg) {
+	if(chg.what == change::kind::remove_all) {
+		root.entries.clear();
+		root.loaded = root.dirty = true;
+		return true;
+	}
+
+	std::vector<tree_node *> chain;
+	std::uint32_t mode = chg.mode;
+	git_oid id         = chg.id;
+	if(chg.what == change::kind::rename || chg.what == change::kind::copy) {
+		if(!descend(root, chg.from, false, chain))
+			return false;
+		const auto itr = chain.back()->entries.find(chg.from.substr(chg.from.rfind('/') + 1));
+		if(itr == chain.back()->entries.end())
+			return false;
+
+		// A tree changed since it was loaded only has an ID once it's written
+		if(itr->second.tree) {
+			const auto written = write_tree(*itr->second.tree);
+			if(!written)
+				return false;
+			itr->second.id = *written;
+		}
+		mode = itr->second.mode;
+		id   = itr->second.id;
+
+		if(chg.what == change::kind::rename) {
+			chain.back()->entries.erase(itr);
+			for(auto node : chain)
+				node->dirty = true;
+		}
+	} else if(chg.what == change::kind::remove) {
+		if(!descend(root, chg.path, false, chain))
+			return true;
+		if(chain.back()->entries.erase(chg.path.substr(chg.path.rfind('/') + 1)))
+			for(auto node : chain)
+				node->dirty = true;
+		return true;
+	}
+
+	const auto name = chg.path.substr(chg.path.rfind('/') + 1);
+	if(name.empty() || !descend(root, chg.path, true, chain))
+		return false;
+	auto & ent = chain.back()->entries[name];
+	ent.mode   = mode;
+	ent.id     = id;
+	ent.tree.reset();
+	for(auto node : chain)
+		node->dirty = true;
+	return true;
+}
+
+std::experimental::optional<git_oid> git2pp::fast_import::write_tree(tree_node & node) {
+	if(!node.dirty)
+		return node.id;
+
+	// Git sorts trees as if their names ended in a slash
+	std::vector<std::pair<std::string, const tree_node::entry *>> sorted;
+	for(auto itr = node.entries.begin(); itr != node.entries.end();) {
+		auto & ent = itr->second;
+		if(ent.tree && ent.tree->dirty) {
+			const auto written = write_tree(*ent.tree);
+			if(!written)
+				return std::experimental::nullopt;
+			ent.id = *written;
+
+			// Emptied directories go away
+			if(ent.tree->entries.empty()) {
+				itr = node.entries.erase(itr);
+				continue;
+			}
+		}
+		sorted.emplace_back(ent.mode == mode_tree ? itr->first + '/' : itr->first, &ent);
+		++itr;
+	}
+	std::sort(sorted.begin(), sorted.end(), [](auto && lhs, auto && rhs) { return lhs.first < rhs.first; });
+
+	std::string contents;
+	char mode[16];
+	for(auto && ent : sorted) {
+		contents.append(mode, std::snprintf(mode, sizeof(mode), "%o ", ent.second->mode));
+		contents.append(ent.first, 0, ent.second->mode == mode_tree ? ent.first.size() - 1 : ent.first.size()).push_back('\0');
+		contents.append(reinterpret_cast<const char *>(ent.second->id.id), GIT_OID_RAWSZ);
+	}
+
+	const auto id = write(contents.data(), contents.size(), GIT_OBJ_TREE);
+	if(failed)
+		return std::experimental::nullopt;
+	node.id    = id;
+	node.dirty = false;
+	return id;
+}
+
+git_oid git2pp::fast_import::write(const void * data, std::size_t size, git_otype type) {
+	git_oid id{};
+	if(failed || git_odb_write(&id, db.get(), data, size, type)) {
+		failed = true;
+		return {};
+	}
+
+	++batched_objects;
+	batched_bytes += size;
+	if(batched_objects >= batch_objects || batched_bytes >= batch_bytes)
+		flush();
+	return id;
+}
+
+bool git2pp::fast_import::flush() {
+	pack.flush();
+	batched_objects = batched_bytes = 0;
+	if(pack.pending())
+		failed = true;
+	return !failed;
+}
+
+
+static void append_signature(std::string & out, const char * header, const git_signature & sig) {
+	const auto offset = sig.when.offset < 0 ? -sig.when.offset : sig.when.offset;
+	char when[64];
+	out.append(header).append(sig.name).append(" <").append(sig.email).append("> ");
+	out.append(when, std::snprintf(when, sizeof(when), "%lld %c%02d%02d\n", static_cast<long long>(sig.when.time), sig.when.offset < 0 ? '-' : '+',
+	                                 offset / 60, offset % 60));
+}
+
+static bool read_data(std::istream & in, const std::string & line, std::string & out) {
+	out.clear();
+	if(line.compare(0, 5, "data "))
+		return false;
+
+	// "data <<DELIM" up to a line that's just DELIM, otherwise "data <size>" and exactly that many bytes
+	if(!line.compare(5, 2, "<<")) {
+		const auto delimiter = line.substr(7);
+		for(std::string data_line; std::getline(in, data_line);) {
+			if(data_line == delimiter)
+				return true;
+			out.append(data_line).push_back('\n');
+		}
+		return false;
+	}
+
+	char * end;
+	const auto size = std::strtoull(line.c_str() + 5, &end, 10);
+	if(*end || end == line.c_str() + 5)
+		return false;
+	out.resize(size);
+	if(!in.read(&out[0], size))
+		return false;
+	if(in.peek() == '\n')
+		in.get();
+	return true;
+}
+
+static bool parse_signature(const std::string & line, std::size_t from, std::string & name, std::string & email, git_signature & sig) {
+	// "<name> <<email>> <time> <+hhmm>", the name possibly empty
+	const auto open  = line.find('<', from);
+	const auto close = open == std::string::npos ? open : line.find('>', open);
+	if(close == std::string::npos)
+		return false;
+
+	name  = line.substr(from, (open > from && line[open - 1] == ' ' ? open - 1 : open) - from);
+	email = line.substr(open + 1, close - open - 1);
+
+	char * end;
+	const auto time = std::strtoll(line.c_str() + close + 1, &end, 10);
+	if(*end != ' ' || (end[1] != '+' && end[1] != '-') || std::strlen(end + 2) != 4)
+		return false;
+	const auto zone = std::atoi(end + 2);
+
+	sig.name        = &name[0];
+	sig.email       = &email[0];
+	sig.when.time   = time;
+	sig.when.offset = (zone / 100 * 60 + zone % 100) * (end[1] == '-' ? -1 : 1);
+	return true;
+}
+
+static bool parse_mode(const std::string & mode, std::uint32_t & out) noexcept {
+	char * end;
+	out = static_cast<std::uint32_t>(std::strtoul(mode.c_str(), &end, 8));
+	if(*end || mode.empty())
+		return false;
+
+	switch(out) {
+		case 0644:
+			out = GIT_FILEMODE_BLOB;
+			return true;
+		case 0755:
+			out = GIT_FILEMODE_BLOB_EXECUTABLE;
+			return true;
+		case GIT_FILEMODE_BLOB:
+		case GIT_FILEMODE_BLOB_EXECUTABLE:
+		case GIT_FILEMODE_LINK:
+		case GIT_FILEMODE_COMMIT:
+		case GIT_FILEMODE_TREE:
+			return true;
+		default:
+			return false;
+	}
+}
+
+static bool parse_path(const std::string & line, std::size_t & pos, bool to_space, std::string & out) {
+	out.clear();
+	if(pos >= line.size())
+		return false;
+
+	// Unquoted runs to the end of the line, or the next space if there's something after it
+	if(line[pos] != '"') {
+		const auto end = to_space ? line.find(' ', pos) : std::string::npos;
+		out            = line.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+		pos            = end == std::string::npos ? line.size() : end;
+		return !out.empty();
+	}
+
+	// C-style, with octal escapes for bytes
+	for(++pos; pos < line.size(); ++pos) {
+		auto c = line[pos];
+		if(c == '"') {
+			++pos;
+			return !out.empty();
+		}
+		if(c == '\\' && ++pos < line.size()) {
+			c = line[pos];
+			switch(c) {
+				case 'a':
+					c = '\a';
+					break;
+				case 'b':
+					c = '\b';
+					break;
+				case 'f':
+					c = '\f';
+					break;
+				case 'n':
+					c = '\n';
+					break;
+				case 'r':
+					c = '\r';
+					break;
+				case 't':
+					c = '\t';
+					break;
+				case 'v':
+					c = '\v';
+					break;
+				default:
+					if(c >= '0' && c <= '3' && pos + 2 < line.size()) {
+						c = static_cast<char>(((c - '0') << 6) | ((line[pos + 1] - '0') << 3) | (line[pos + 2] - '0'));
+						pos += 2;
+					}
+			}
+		}
+		out.push_back(c);
+	}
+	return false;
+}
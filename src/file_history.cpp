@@ -0,0 +1,194 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/file_history.hpp"
+#include "libgit2++/commit_graph.hpp"
+#include "libgit2++/commit_view.hpp"
+#include "libgit2++/detail/scope.hpp"
+#include "libgit2++/detail/tree_diff.hpp"
+#include "libgit2++/repository.hpp"
+#include <git2/diff.h>
+#include <git2/tree.h>
+
+
+static std::experimental::optional<std::string> rename_source(git_repository * repo, const git_oid & old_tree, const git_oid & new_tree,
+                                                              const std::string & path);
+
+
+auto git2pp::file_history::iterator::operator*() const noexcept -> reference {
+	return current;
+}
+
+auto git2pp::file_history::iterator::operator->() const noexcept -> pointer {
+	return &current;
+}
+
+auto git2pp::file_history::iterator::operator++() -> iterator & {
+	if(const auto id = history->next())
+		current = *id;
+	else
+		history = nullptr;
+	return *this;
+}
+
+auto git2pp::file_history::iterator::operator++(int) -> iterator {
+	auto prev = *this;
+	++*this;
+	return prev;
+}
+
+bool git2pp::file_history::iterator::operator==(const iterator & other) const noexcept {
+	return history == other.history;
+}
+
+bool git2pp::file_history::iterator::operator!=(const iterator & other) const noexcept {
+	return history != other.history;
+}
+
+
+git2pp::file_history::iterator::iterator(file_history * h) : history(h), current{} {
+	if(history)
+		++*this;
+}
+
+
+std::experimental::optional<git_oid> git2pp::file_history::next() {
+	git_oid tree;
+	std::vector<git_oid> parents;
+	std::vector<git_oid> parent_trees;
+	while(const auto id = walk.next()) {
+		if(graph)
+			if(const auto pos = graph->position(*id))
+				if(!graph->maybe_changed(*pos, searched_path))
+					continue;
+
+		if(!read_commit(*id, tree, parents))
+			return std::experimental::nullopt;
+
+		git_oid entry, parent_entry;
+		std::uint32_t mode, parent_mode;
+		const auto present = detail::tree_entry_at(db.get(), tree, searched_path, entry, mode);
+
+		// Same as any one parent means the change, if any, came from that side
+		bool same_as_parent = false, in_any_parent = false;
+		parent_trees.clear();
+		for(auto && parent : parents) {
+			std::vector<git_oid> grandparents;
+			parent_trees.emplace_back();
+			if(!read_commit(parent, parent_trees.back(), grandparents))
+				return std::experimental::nullopt;
+
+			const auto parent_present = detail::tree_entry_at(db.get(), parent_trees.back(), searched_path, parent_entry, parent_mode);
+			in_any_parent |= parent_present;
+			if(parent_present == present && (!present || (!git_oid_cmp(&entry, &parent_entry) && mode == parent_mode))) {
+				same_as_parent = true;
+				break;
+			}
+		}
+		if(same_as_parent || (!present && parents.empty()))
+			continue;
+
+		found_path = searched_path;
+		if(follow_renames && present && !in_any_parent && !parents.empty())
+			if(auto from = rename_source(repo, parent_trees.front(), tree, searched_path))
+				searched_path = std::move(*from);
+		return *id;
+	}
+	return std::experimental::nullopt;
+}
+
+const std::string & git2pp::file_history::path() const noexcept {
+	return found_path;
+}
+
+auto git2pp::file_history::begin() -> iterator {
+	return {this};
+}
+
+auto git2pp::file_history::end() -> iterator {
+	return {nullptr};
+}
+
+
+git2pp::file_history::file_history(repository & r, const git_oid & start, std::string p, bool follow, const commit_graph * g)
+      : repo(r.repo.get()), walk(r), graph(g && g->valid() ? g : nullptr), follow_renames(follow), searched_path(std::move(p)) {
+	git_odb * db_raw{};
+	git_repository_odb(&db_raw, repo);
+	db.reset(db_raw);
+
+	walk.sorting(revwalk_sort::topological | revwalk_sort::time);
+	walk.push(start);
+}
+
+
+bool git2pp::file_history::read_commit(const git_oid & id, git_oid & tree, std::vector<git_oid> & parents) const {
+	parents.clear();
+	if(graph)
+		if(const auto pos = graph->position(id)) {
+			tree = graph->tree_id(*pos);
+			graph->for_each_parent(*pos, [&](auto parent) { parents.emplace_back(graph->id(parent)); });
+			return true;
+		}
+
+	git_odb_object * obj{};
+	if(!db || git_odb_read(&obj, db.get(), &id))
+		return false;
+	detail::quickscope_wrapper obj_cleanup{[&]() { git_odb_object_free(obj); }};
+
+	const commit_view view(static_cast<const char *>(git_odb_object_data(obj)), git_odb_object_size(obj));
+	if(git_odb_object_type(obj) != GIT_OBJ_COMMIT || !view.valid())
+		return false;
+
+	tree                  = view.tree_id();
+	const auto parent_ids = view.parent_ids();
+	parents.assign(parent_ids.begin(), parent_ids.end());
+	return true;
+}
+
+
+static std::experimental::optional<std::string> rename_source(git_repository * repo, const git_oid & old_tree, const git_oid & new_tree,
+                                                              const std::string & path) {
+	git_tree * old_trr{};
+	git_tree * new_trr{};
+	git_diff * diff{};
+	git2pp::detail::quickscope_wrapper cleanup{[&]() {
+		git_diff_free(diff);
+		git_tree_free(new_trr);
+		git_tree_free(old_trr);
+	}};
+	if(git_tree_lookup(&old_trr, repo, &old_tree) || git_tree_lookup(&new_trr, repo, &new_tree) || git_diff_tree_to_tree(&diff, repo, old_trr, new_trr, nullptr))
+		return std::experimental::nullopt;
+
+	git_diff_find_options opts = GIT_DIFF_FIND_OPTIONS_INIT;
+	opts.flags                 = GIT_DIFF_FIND_RENAMES;
+	if(git_diff_find_similar(diff, &opts))
+		return std::experimental::nullopt;
+
+	const auto deltas = git_diff_num_deltas(diff);
+	for(std::size_t i = 0; i < deltas; ++i) {
+		const auto delta = git_diff_get_delta(diff, i);
+		if(delta->status == GIT_DELTA_RENAMED && path == delta->new_file.path)
+			return std::string(delta->old_file.path);
+	}
+	return std::experimental::nullopt;
+}
@@ -22,13 +22,47 @@
 
 
 #include "libgit2++/guard.hpp"
+#include <atomic>
+#include <cstddef>
 #include <git2/global.h>
 
 
-git2pp::guard::guard() {
+static std::atomic<std::size_t> runtimes{0};
+
+
+bool git2pp::runtime::active() noexcept {
+	return runtimes.load(std::memory_order_acquire);
+}
+
+git2pp::runtime::runtime() {
 	git_libgit2_init();
+	runtimes.fetch_add(1, std::memory_order_release);
 }
 
-git2pp::guard::~guard() {
+git2pp::runtime::runtime(const runtime &) : runtime() {}
+
+git2pp::runtime::~runtime() {
+	runtimes.fetch_sub(1, std::memory_order_release);
 	git_libgit2_shutdown();
 }
+
+git2pp::runtime & git2pp::runtime::operator=(const runtime &) noexcept {
+	return *this;
+}
+
+
+git2pp::guard::guard() : initialised(!runtime::active()) {
+	if(initialised)
+		git_libgit2_init();
+}
+
+git2pp::guard::guard(const guard &) : guard() {}
+
+git2pp::guard::~guard() {
+	if(initialised)
+		git_libgit2_shutdown();
+}
+
+git2pp::guard & git2pp::guard::operator=(const guard &) noexcept {
+	return *this;
+}
@@ -0,0 +1,123 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/history_table.hpp"
+#include "libgit2++/commit_view.hpp"
+#include "libgit2++/detail/parallel.hpp"
+#include "libgit2++/detail/scope.hpp"
+#include "libgit2++/odb.hpp"
+#include "libgit2++/repository.hpp"
+#include "libgit2++/revwalk.hpp"
+#include <algorithm>
+#include <atomic>
+#include <git2/odb.h>
+
+
+std::size_t git2pp::history_table::size() const noexcept {
+	return ids.size();
+}
+
+
+git2pp::history_table::history_table(repository & repo, revwalk & walk, std::size_t threads) {
+	for(auto && id : walk)
+		ids.emplace_back(id);
+
+	git_odb * db_raw{};
+	if(git_repository_odb(&db_raw, repo.repo.get())) {
+		ids.clear();
+		return;
+	}
+	std::unique_ptr<git_odb, odb_deleter> db(db_raw);
+
+	const auto rows = ids.size();
+	tree_ids.resize(rows);
+	times.resize(rows);
+	time_offsets.resize(rows);
+	authors.resize(rows);
+	committers.resize(rows);
+	parent_offsets.resize(rows + 1);
+
+	// Each slice interns into and collects parents of its own, merged in slice order afterwards
+	threads = detail::thread_count(rows, threads, 256);
+	std::vector<signature_pool> slice_people(threads);
+	std::vector<std::vector<git_oid>> slice_parents(threads);
+	std::vector<std::pair<std::size_t, std::size_t>> slices(threads);
+	std::atomic<bool> failed{false};
+	detail::parallel_for(rows, threads, [&](auto idx, auto begin, auto end) {
+		slices[idx]        = {begin, end};
+		auto & people_out  = slice_people[idx];
+		auto & parents_out = slice_parents[idx];
+
+		for(auto row = begin; row != end && !failed; ++row) {
+			git_odb_object * obj{};
+			if(git_odb_read(&obj, db.get(), &ids[row])) {
+				failed = true;
+				break;
+			}
+			detail::quickscope_wrapper obj_cleanup{[&]() { git_odb_object_free(obj); }};
+
+			const commit_view view(static_cast<const char *>(git_odb_object_data(obj)), git_odb_object_size(obj));
+			if(git_odb_object_type(obj) != GIT_OBJ_COMMIT || !view.valid()) {
+				failed = true;
+				break;
+			}
+
+			tree_ids[row]     = view.tree_id();
+			times[row]        = view.time();
+			time_offsets[row] = view.time_offset();
+			authors[row]      = people_out.intern_raw(view.author());
+			committers[row]   = people_out.intern_raw(view.committer());
+
+			const auto parents      = view.parent_ids();
+			const auto parents_from = parents_out.size();
+			parents_out.insert(parents_out.end(), parents.begin(), parents.end());
+			parent_offsets[row + 1] = static_cast<std::uint32_t>(parents_out.size() - parents_from);
+		}
+	});
+	if(failed) {
+		ids.clear();
+		tree_ids.clear();
+		times.clear();
+		time_offsets.clear();
+		authors.clear();
+		committers.clear();
+		parent_offsets.clear();
+		return;
+	}
+
+	for(std::size_t row = 0; row < rows; ++row)
+		parent_offsets[row + 1] += parent_offsets[row];
+	parent_ids.reserve(parent_offsets.back());
+	for(auto && parents : slice_parents)
+		parent_ids.insert(parent_ids.end(), parents.begin(), parents.end());
+
+	for(std::size_t i = 0; i < threads; ++i) {
+		const auto remap = people.merge(slice_people[i]);
+		for(auto row = slices[i].first; row != slices[i].second; ++row) {
+			authors[row]    = remap[authors[row]];
+			committers[row] = remap[committers[row]];
+		}
+	}
+}
+
+
@@ -0,0 +1,132 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/lookup_cache.hpp"
+#include "libgit2++/repository.hpp"
+#include <cstring>
+#include <git2/commit.h>
+#include <git2/tree.h>
+
+
+// Rough libgit2-side footprint of a parsed object besides its variable-size data
+static const std::size_t object_overhead     = 128;
+static const std::size_t tree_entry_overhead = 64;
+
+
+std::shared_ptr<const git2pp::commit> git2pp::lookup_cache::commit_lookup(const git_oid & id) {
+	if(const auto ent = find(id))
+		if(ent->cmt) {
+			++hits;
+			return ent->cmt;
+		}
+	++misses;
+
+	git_commit * result{};
+	if(git_commit_lookup(&result, repo, &id))
+		return nullptr;
+
+	std::shared_ptr<const commit> cmt(new commit(result));
+	insert({id, cmt, nullptr, object_overhead + std::strlen(git_commit_raw_header(result)) + std::strlen(git_commit_message_raw(result))});
+	return cmt;
+}
+
+std::shared_ptr<const git2pp::commit_tree> git2pp::lookup_cache::tree_lookup(const git_oid & id) {
+	if(const auto ent = find(id))
+		if(ent->trr) {
+			++hits;
+			return ent->trr;
+		}
+	++misses;
+
+	git_tree * result{};
+	if(git_tree_lookup(&result, repo, &id))
+		return nullptr;
+
+	std::shared_ptr<const commit_tree> trr(new commit_tree(result));
+	insert({id, nullptr, trr, object_overhead + git_tree_entrycount(result) * tree_entry_overhead});
+	return trr;
+}
+
+git2pp::lookup_cache_stats git2pp::lookup_cache::stats() const noexcept {
+	return {hits, misses, evictions, lru.size(), bytes};
+}
+
+void git2pp::lookup_cache::reset_stats() noexcept {
+	hits      = 0;
+	misses    = 0;
+	evictions = 0;
+}
+
+std::size_t git2pp::lookup_cache::budget() const noexcept {
+	return max_bytes;
+}
+
+void git2pp::lookup_cache::budget(std::size_t b) {
+	max_bytes = b;
+	shrink();
+}
+
+void git2pp::lookup_cache::clear() noexcept {
+	lru.clear();
+	index.clear();
+	bytes = 0;
+}
+
+
+git2pp::lookup_cache::lookup_cache(repository & r, std::size_t b) : repo(r.repo.get()), max_bytes(b), bytes(0), hits(0), misses(0), evictions(0) {}
+
+
+git2pp::lookup_cache::entry * git2pp::lookup_cache::find(const oid & id) noexcept {
+	const auto itr = index.find(id);
+	if(!itr)
+		return nullptr;
+
+	lru.splice(lru.begin(), lru, *itr);
+	return &lru.front();
+}
+
+void git2pp::lookup_cache::insert(entry ent) {
+	// Same ID looked up as the other type
+	if(const auto existing = index.find(ent.id)) {
+		bytes -= (*existing)->cost;
+		lru.erase(*existing);
+		index.erase(ent.id);
+	}
+
+	if(ent.cost > max_bytes)
+		return;
+
+	bytes += ent.cost;
+	lru.push_front(std::move(ent));
+	index.insert(lru.front().id, lru.begin());
+	shrink();
+}
+
+void git2pp::lookup_cache::shrink() noexcept {
+	while(bytes > max_bytes) {
+		bytes -= lru.back().cost;
+		index.erase(lru.back().id);
+		lru.pop_back();
+		++evictions;
+	}
+}
@@ -0,0 +1,283 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/mempack.hpp"
+#include "libgit2++/detail/scope.hpp"
+#include "libgit2++/repository.hpp"
+#include <git2/buffer.h>
+#include <git2/odb_backend.h>
+#include <git2/pack.h>
+#include <git2/sys/odb_backend.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace {
+	// git_mempack_dump() only packs the commits in the mempack and what they reach, which leaves out blobs and trees nothing's committed yet,
+	// so every write goes through this on its way to the mempack, keeping the IDs to pack instead.
+	// Once the mempack is gone, writes go to the object directory, since the backend can't be taken back out of the repository's odb
+	struct write_recorder {
+		git_odb_backend parent;
+		std::mutex lock;
+		std::vector<git_oid> written;
+		// Bumped by reset(), so flush() knows whether what it packed is still at the front of written
+		std::size_t generation;
+		git_odb_backend * memory;
+		// Taken off the mempack, so nothing can write to it without going through here
+		decltype(git_odb_backend::write) memory_write;
+		git_odb * disk;
+		bool active;
+	};
+
+	// libgit2 picks the first backend that can write for streams, so this one has to stream too
+	struct recording_stream {
+		git_odb_stream parent;
+		git_otype type;
+		std::string data;
+		// Streamed straight to disk if the mempack was already gone when this was opened
+		git_odb_stream * disk;
+	};
+}
+
+
+static git_odb_backend * new_recorder(git_odb_backend * memory, decltype(git_odb_backend::write) memory_write, git_odb * disk);
+static int store(write_recorder & rec, const git_oid * id, const void * data, std::size_t size, git_otype type);
+static write_recorder & recorder_of(git_odb_backend * backend) noexcept;
+static recording_stream & stream_of(git_odb_stream * stream) noexcept;
+
+
+bool git2pp::mempack::valid() const noexcept {
+	return recorder != nullptr;
+}
+
+std::size_t git2pp::mempack::flush() noexcept {
+	if(!valid())
+		return 0;
+
+	auto & rec = recorder_of(recorder);
+	std::vector<git_oid> written;
+	std::size_t generation;
+	{
+		std::lock_guard<std::mutex> lck(rec.lock);
+		written    = rec.written;
+		generation = rec.generation;
+	}
+	if(written.empty())
+		return 0;
+
+	git_packbuilder * builder{};
+	git_buf pack{};
+	detail::quickscope_wrapper pack_cleanup{[&]() {
+		git_buf_free(&pack);
+		git_packbuilder_free(builder);
+	}};
+
+	if(git_packbuilder_new(&builder, repo))
+		return 0;
+	for(auto && id : written)
+		if(git_packbuilder_insert(builder, &id, nullptr))
+			return 0;
+	if(git_packbuilder_write_buf(&pack, builder))
+		return 0;
+	const auto objects = git_packbuilder_object_count(builder);
+
+	git_odb_writepack * writepack{};
+	if(git_odb_write_pack(&writepack, db.get(), nullptr, nullptr))
+		return 0;
+	detail::quickscope_wrapper writepack_cleanup{[&]() { writepack->free(writepack); }};
+
+	git_transfer_progress stats{};
+	if(writepack->append(writepack, pack.ptr, pack.size, &stats) || writepack->commit(writepack, &stats))
+		return 0;
+
+	// Objects written while this was packing stay for the next flush(), and so does the mempack's copy of them
+	std::lock_guard<std::mutex> lck(rec.lock);
+	if(rec.generation == generation)
+		rec.written.erase(rec.written.begin(), rec.written.begin() + written.size());
+	if(rec.written.empty())
+		git_mempack_reset(backend);
+	return objects;
+}
+
+void git2pp::mempack::reset() noexcept {
+	if(!valid())
+		return;
+
+	auto & rec = recorder_of(recorder);
+	std::lock_guard<std::mutex> lck(rec.lock);
+	git_mempack_reset(backend);
+	rec.written.clear();
+	++rec.generation;
+}
+
+std::size_t git2pp::mempack::pending() const noexcept {
+	if(!valid())
+		return 0;
+
+	auto & rec = recorder_of(recorder);
+	std::lock_guard<std::mutex> lck(rec.lock);
+	return rec.written.size();
+}
+
+
+git2pp::mempack::mempack(repository & r, int priority) noexcept : repo(r.repo.get()), backend(nullptr), recorder(nullptr) {
+	git_odb * result{};
+	if(git_repository_odb(&result, repo))
+		return;
+	db.reset(result);
+
+	// Where writes go once this is gone; without it there's nowhere to put them, so nothing's captured
+	git_odb * disk{};
+	git_buf objects_dir{};
+	const auto opened = !git_repository_item_path(&objects_dir, repo, GIT_REPOSITORY_ITEM_OBJECTS) && !git_odb_open(&disk, objects_dir.ptr);
+	git_buf_free(&objects_dir);
+	if(!opened)
+		return;
+
+	git_odb_backend * memory{};
+	if(git_mempack_new(&memory)) {
+		git_odb_free(disk);
+		return;
+	}
+
+	// Read-only in the odb, so if the recorder can't be added in front of it writes still reach the object directory
+	const auto memory_write = memory->write;
+	memory->write           = nullptr;
+	if(git_odb_add_backend(db.get(), memory, priority)) {
+		memory->free(memory);
+		git_odb_free(disk);
+		return;
+	}
+
+	// Writes go to backends in priority order until one takes them
+	const auto rec = new_recorder(memory, memory_write, disk);
+	if(git_odb_add_backend(db.get(), rec, priority + 1)) {
+		rec->free(rec);
+		return;
+	}
+
+	backend  = memory;
+	recorder = rec;
+}
+
+git2pp::mempack::~mempack() {
+	if(!valid())
+		return;
+
+	{
+		auto & rec = recorder_of(recorder);
+		std::lock_guard<std::mutex> lck(rec.lock);
+		rec.active = false;
+	}
+	flush();
+}
+
+
+static git_odb_backend * new_recorder(git_odb_backend * memory, decltype(git_odb_backend::write) memory_write, git_odb * disk) {
+	const auto rec = new write_recorder{};
+	git_odb_init_backend(&rec->parent, GIT_ODB_BACKEND_VERSION);
+	rec->memory       = memory;
+	rec->memory_write = memory_write;
+	rec->disk         = disk;
+	rec->active       = true;
+
+	rec->parent.write = [](git_odb_backend * backend, const git_oid * id, const void * data, std::size_t size, git_otype type) {
+		return store(recorder_of(backend), id, data, size, type);
+	};
+	rec->parent.writestream = [](git_odb_stream ** out, git_odb_backend * backend, git_off_t size, git_otype type) {
+		auto & self = recorder_of(backend);
+		bool active;
+		{
+			std::lock_guard<std::mutex> lck(self.lock);
+			active = self.active;
+		}
+
+		const auto stream = new recording_stream{};
+		stream->type      = type;
+		if(!active) {
+			if(const auto err = git_odb_open_wstream(&stream->disk, self.disk, size, type)) {
+				delete stream;
+				return err;
+			}
+		} else
+			stream->data.reserve(static_cast<std::size_t>(size));
+
+		stream->parent.backend        = backend;
+		stream->parent.mode           = GIT_STREAM_WRONLY;
+		stream->parent.write          = [](git_odb_stream * strm, const char * buffer, std::size_t len) {
+			auto & self = stream_of(strm);
+			if(self.disk)
+				return git_odb_stream_write(self.disk, buffer, len);
+			self.data.append(buffer, len);
+			return 0;
+		};
+		stream->parent.finalize_write = [](git_odb_stream * strm, const git_oid * id) {
+			auto & self = stream_of(strm);
+			if(self.disk) {
+				git_oid written;
+				return git_odb_stream_finalize_write(&written, self.disk);
+			}
+			return store(recorder_of(strm->backend), id, self.data.data(), self.data.size(), self.type);
+		};
+		stream->parent.free = [](git_odb_stream * strm) {
+			auto & self = stream_of(strm);
+			if(self.disk)
+				git_odb_stream_free(self.disk);
+			delete &self;
+		};
+
+		*out = &stream->parent;
+		return 0;
+	};
+	rec->parent.foreach = [](git_odb_backend *, git_odb_foreach_cb, void *) { return 0; };
+	rec->parent.free    = [](git_odb_backend * backend) {
+		auto & self = recorder_of(backend);
+		git_odb_free(self.disk);
+		delete &self;
+	};
+	return &rec->parent;
+}
+
+static int store(write_recorder & rec, const git_oid * id, const void * data, std::size_t size, git_otype type) {
+	{
+		std::lock_guard<std::mutex> lck(rec.lock);
+		if(rec.active) {
+			const auto err = rec.memory_write(rec.memory, id, data, size, type);
+			if(!err)
+				rec.written.emplace_back(*id);
+			return err;
+		}
+	}
+
+	git_oid written;
+	return git_odb_write(&written, rec.disk, data, size, type);
+}
+
+static write_recorder & recorder_of(git_odb_backend * backend) noexcept {
+	return *reinterpret_cast<write_recorder *>(backend);
+}
+
+static recording_stream & stream_of(git_odb_stream * stream) noexcept {
+	return *reinterpret_cast<recording_stream *>(stream);
+}
@@ -0,0 +1,116 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/odb.hpp"
+#include <algorithm>
+#include <iterator>
+
+
+void git2pp::odb_deleter::operator()(git_odb * db) const noexcept {
+	git_odb_free(db);
+}
+
+void git2pp::odb_object_deleter::operator()(git_odb_object * obj) const noexcept {
+	git_odb_object_free(obj);
+}
+
+
+const git_oid & git2pp::odb_object::id() const noexcept {
+	return *git_odb_object_id(obj.get());
+}
+
+git2pp::object_type git2pp::odb_object::type() const noexcept {
+	return static_cast<object_type>(git_odb_object_type(obj.get()));
+}
+
+std::size_t git2pp::odb_object::size() const noexcept {
+	return git_odb_object_size(obj.get());
+}
+
+const void * git2pp::odb_object::data() const noexcept {
+	return git_odb_object_data(obj.get());
+}
+
+
+git2pp::odb_object::odb_object(git_odb_object * r) noexcept : obj(r) {}
+
+
+std::experimental::optional<git2pp::odb_header> git2pp::odb::read_header(const git_oid & id) const noexcept {
+	std::size_t size;
+	git_otype type;
+	if(git_odb_read_header(&size, &type, db.get(), &id))
+		return std::experimental::nullopt;
+	else
+		return odb_header{static_cast<object_type>(type), size};
+}
+
+std::vector<std::experimental::optional<git2pp::odb_header>> git2pp::odb::read_headers(const std::vector<git_oid> & ids) const {
+	std::vector<std::experimental::optional<odb_header>> result;
+	result.reserve(ids.size());
+	std::transform(ids.begin(), ids.end(), std::back_inserter(result), [&](auto && id) { return this->read_header(id); });
+	return result;
+}
+
+bool git2pp::odb::exists(const git_oid & id) const noexcept {
+	return git_odb_exists(db.get(), &id);
+}
+
+std::vector<bool> git2pp::odb::exists_many(const std::vector<git_oid> & ids) const {
+	std::vector<git_odb_expand_id> expanded;
+	expanded.reserve(ids.size());
+	std::transform(ids.begin(), ids.end(), std::back_inserter(expanded), [](auto && id) { return git_odb_expand_id{id, GIT_OID_HEXSZ, GIT_OBJ_ANY}; });
+
+	git_odb_expand_ids(db.get(), expanded.data(), expanded.size());
+
+	std::vector<bool> result;
+	result.reserve(ids.size());
+	std::transform(expanded.begin(), expanded.end(), std::back_inserter(result), [](auto && id) { return id.length != 0; });
+	return result;
+}
+
+std::experimental::optional<git_oid> git2pp::odb::exists_prefix(const git_oid & id, std::size_t prefix_len) const noexcept {
+	git_oid result;
+	if(git_odb_exists_prefix(&result, db.get(), &id, prefix_len))
+		return std::experimental::nullopt;
+	else
+		return {result};
+}
+
+git2pp::odb_object git2pp::odb::read(const git_oid & id) const noexcept {
+	git_odb_object * result{};
+	git_odb_read(&result, db.get(), &id);
+	return {result};
+}
+
+git2pp::odb_object git2pp::odb::read_prefix(const git_oid & id, std::size_t prefix_len) const noexcept {
+	git_odb_object * result{};
+	git_odb_read_prefix(&result, db.get(), &id, prefix_len);
+	return {result};
+}
+
+void git2pp::odb::refresh() noexcept {
+	git_odb_refresh(db.get());
+}
+
+
+git2pp::odb::odb(git_odb * r) noexcept : db(r) {}
@@ -0,0 +1,162 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/oid.hpp"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+constexpr std::size_t git2pp::oid::size;
+constexpr std::size_t git2pp::oid::hex_size;
+
+
+static void encode_scalar(const unsigned char * in, char * out, std::size_t count) noexcept;
+static bool decode_scalar(const char * in, unsigned char * out, std::size_t count) noexcept;
+
+
+std::experimental::optional<git2pp::oid> git2pp::oid::from_hex(std::experimental::string_view hex) noexcept {
+	if(hex.size() != hex_size)
+		return std::experimental::nullopt;
+
+	oid result;
+	std::size_t done = 0;
+#ifdef __SSE2__
+	// 32 digits into 16 bytes; the last 8 digits go through the scalar path
+	const auto decode = [](__m128i chars, bool & valid) {
+		const auto lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+		const auto digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+		const auto alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+		valid &= _mm_movemask_epi8(_mm_or_si128(digit, alpha)) == 0xFFFF;
+
+		const auto nibbles = _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+		                                  _mm_and_si128(alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+		// Each 16-bit lane holds (high digit, low digit) in memory order
+		return _mm_and_si128(_mm_or_si128(_mm_slli_epi16(nibbles, 4), _mm_srli_epi16(nibbles, 8)), _mm_set1_epi16(0x00FF));
+	};
+
+	bool valid = true;
+	const auto first  = decode(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hex.data())), valid);
+	const auto second = decode(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hex.data() + 16)), valid);
+	if(!valid)
+		return std::experimental::nullopt;
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(result.raw.id), _mm_packus_epi16(first, second));
+	done = 16;
+#endif
+
+	if(!decode_scalar(hex.data() + done * 2, result.raw.id + done, size - done))
+		return std::experimental::nullopt;
+	return result;
+}
+
+const unsigned char * git2pp::oid::data() const noexcept {
+	return raw.id;
+}
+
+bool git2pp::oid::zero() const noexcept {
+	return *this == oid{};
+}
+
+void git2pp::oid::to_hex(char (&out)[hex_size + 1]) const noexcept {
+	std::size_t done = 0;
+#ifdef __SSE2__
+	// 16 bytes into 32 digits; the last 4 bytes go through the scalar path
+	const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(raw.id));
+	const auto mask  = _mm_set1_epi8(0x0F);
+	const auto high  = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+	const auto low   = _mm_and_si128(bytes, mask);
+
+	const auto encode = [](__m128i nibbles) {
+		const auto letter = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+		return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letter);
+	};
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(out), encode(_mm_unpacklo_epi8(high, low)));
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), encode(_mm_unpackhi_epi8(high, low)));
+	done = 16;
+#endif
+
+	encode_scalar(raw.id + done, out + done * 2, size - done);
+	out[hex_size] = '\0';
+}
+
+std::string git2pp::oid::str() const {
+	char buf[hex_size + 1];
+	to_hex(buf);
+	return {buf, hex_size};
+}
+
+int git2pp::oid::compare(const oid & other) const noexcept {
+	return std::memcmp(raw.id, other.raw.id, size);
+}
+
+git2pp::oid::operator const git_oid &() const noexcept {
+	return raw;
+}
+
+
+git2pp::oid::oid(const git_oid & id) noexcept : raw(id) {}
+
+
+bool git2pp::operator==(const oid & lhs, const oid & rhs) noexcept {
+	return !lhs.compare(rhs);
+}
+
+bool git2pp::operator!=(const oid & lhs, const oid & rhs) noexcept {
+	return lhs.compare(rhs);
+}
+
+bool git2pp::operator<(const oid & lhs, const oid & rhs) noexcept {
+	return lhs.compare(rhs) < 0;
+}
+
+bool git2pp::operator<=(const oid & lhs, const oid & rhs) noexcept {
+	return lhs.compare(rhs) <= 0;
+}
+
+bool git2pp::operator>(const oid & lhs, const oid & rhs) noexcept {
+	return lhs.compare(rhs) > 0;
+}
+
+bool git2pp::operator>=(const oid & lhs, const oid & rhs) noexcept {
+	return lhs.compare(rhs) >= 0;
+}
+
+
+static void encode_scalar(const unsigned char * in, char * out, std::size_t count) noexcept {
+	static const char digits[] = "0123456789abcdef";
+	for(std::size_t i = 0; i < count; ++i) {
+		out[i * 2]     = digits[in[i] >> 4];
+		out[i * 2 + 1] = digits[in[i] & 0x0F];
+	}
+}
+
+static bool decode_scalar(const char * in, unsigned char * out, std::size_t count) noexcept {
+	for(std::size_t i = 0; i < count; ++i) {
+		const auto high = git2pp::detail::hex_value(in[i * 2]);
+		const auto low  = git2pp::detail::hex_value(in[i * 2 + 1]);
+		if(high < 0 || low < 0)
+			return false;
+		out[i] = static_cast<unsigned char>((high << 4) | low);
+	}
+	return true;
+}
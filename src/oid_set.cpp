@@ -0,0 +1,97 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/oid_set.hpp"
+#include <algorithm>
+#include <iterator>
+
+
+bool git2pp::oid_set::contains(const oid & id) const noexcept {
+	return std::binary_search(ids.begin(), ids.end(), id);
+}
+
+auto git2pp::oid_set::lower_bound(const oid & id) const noexcept -> const_iterator {
+	return std::lower_bound(ids.begin(), ids.end(), id);
+}
+
+bool git2pp::oid_set::insert(const oid & id) {
+	const auto itr = std::lower_bound(ids.begin(), ids.end(), id);
+	if(itr != ids.end() && *itr == id)
+		return false;
+
+	ids.insert(itr, id);
+	return true;
+}
+
+void git2pp::oid_set::insert_many(std::vector<oid> added) {
+	std::sort(added.begin(), added.end());
+
+	const auto old_size = ids.size();
+	ids.reserve(old_size + added.size());
+	std::copy(added.begin(), added.end(), std::back_inserter(ids));
+	std::inplace_merge(ids.begin(), ids.begin() + old_size, ids.end());
+	ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+bool git2pp::oid_set::erase(const oid & id) {
+	const auto itr = std::lower_bound(ids.begin(), ids.end(), id);
+	if(itr == ids.end() || *itr != id)
+		return false;
+
+	ids.erase(itr);
+	return true;
+}
+
+std::size_t git2pp::oid_set::size() const noexcept {
+	return ids.size();
+}
+
+bool git2pp::oid_set::empty() const noexcept {
+	return ids.empty();
+}
+
+void git2pp::oid_set::clear() noexcept {
+	ids.clear();
+}
+
+void git2pp::oid_set::reserve(std::size_t count) {
+	ids.reserve(count);
+}
+
+auto git2pp::oid_set::begin() const noexcept -> const_iterator {
+	return ids.begin();
+}
+
+auto git2pp::oid_set::end() const noexcept -> const_iterator {
+	return ids.end();
+}
+
+const git2pp::oid & git2pp::oid_set::operator[](std::size_t idx) const noexcept {
+	return ids[idx];
+}
+
+
+git2pp::oid_set::oid_set(std::vector<oid> i) : ids(std::move(i)) {
+	std::sort(ids.begin(), ids.end());
+	ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
@@ -0,0 +1,134 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/pack_builder.hpp"
+#include "libgit2++/detail/scope.hpp"
+#include "libgit2++/repository.hpp"
+#include "libgit2++/revwalk.hpp"
+#include <git2/repository.h>
+#include <git2/revwalk.h>
+
+
+void git2pp::pack_builder_deleter::operator()(git_packbuilder * pb) const noexcept {
+	git_packbuilder_free(pb);
+}
+
+
+bool git2pp::pack_builder::insert(const git_oid & id, const char * name) noexcept {
+	return !git_packbuilder_insert(pb.get(), &id, name);
+}
+
+bool git2pp::pack_builder::insert(const git_oid & id, const std::string & name) noexcept {
+	return insert(id, name.c_str());
+}
+
+bool git2pp::pack_builder::insert_tree(const git_oid & id) noexcept {
+	return !git_packbuilder_insert_tree(pb.get(), &id);
+}
+
+bool git2pp::pack_builder::insert_commit(const git_oid & id) noexcept {
+	return !git_packbuilder_insert_commit(pb.get(), &id);
+}
+
+bool git2pp::pack_builder::insert_recursive(const git_oid & id, const char * name) noexcept {
+	return !git_packbuilder_insert_recur(pb.get(), &id, name);
+}
+
+bool git2pp::pack_builder::insert_recursive(const git_oid & id, const std::string & name) noexcept {
+	return insert_recursive(id, name.c_str());
+}
+
+bool git2pp::pack_builder::insert_walk(const std::vector<git_oid> & tips, const std::vector<git_oid> & hidden) noexcept {
+	git_revwalk * walk{};
+	if(git_revwalk_new(&walk, repo))
+		return false;
+	detail::quickscope_wrapper walk_cleanup{[&]() { git_revwalk_free(walk); }};
+
+	for(auto && tip : tips)
+		if(git_revwalk_push(walk, &tip))
+			return false;
+	for(auto && hide : hidden)
+		if(git_revwalk_hide(walk, &hide))
+			return false;
+
+	return !git_packbuilder_insert_walk(pb.get(), walk);
+}
+
+bool git2pp::pack_builder::insert_walk(revwalk & walk) noexcept {
+	return !git_packbuilder_insert_walk(pb.get(), walk.walk.get());
+}
+
+unsigned int git2pp::pack_builder::threads(unsigned int count) noexcept {
+	return git_packbuilder_set_threads(pb.get(), count);
+}
+
+void git2pp::pack_builder::progress(progress_callback func) {
+	if(!func) {
+		git_packbuilder_set_callbacks(pb.get(), nullptr, nullptr);
+		progress_func.reset();
+		return;
+	}
+
+	if(progress_func)
+		*progress_func = std::move(func);
+	else
+		progress_func = std::make_unique<progress_callback>(std::move(func));
+
+	git_packbuilder_set_callbacks(pb.get(),
+	                              [](int stage, std::uint32_t current, std::uint32_t total, void * payload) {
+		                              (*static_cast<progress_callback *>(payload))(static_cast<pack_builder_stage>(stage), current, total);
+		                              return 0;
+		                            },
+	                              progress_func.get());
+}
+
+bool git2pp::pack_builder::write(const char * path, unsigned int mode) noexcept {
+	if(!path)
+		return write(std::string(git_repository_path(repo)) + "objects/pack", mode);
+
+	return !git_packbuilder_write(pb.get(), path, mode, nullptr, nullptr);
+}
+
+bool git2pp::pack_builder::write(const std::string & path, unsigned int mode) noexcept {
+	return write(path.empty() ? nullptr : path.c_str(), mode);
+}
+
+git_oid git2pp::pack_builder::hash() const noexcept {
+	return *git_packbuilder_hash(pb.get());
+}
+
+std::size_t git2pp::pack_builder::object_count() const noexcept {
+	return git_packbuilder_object_count(pb.get());
+}
+
+std::size_t git2pp::pack_builder::written() const noexcept {
+	return git_packbuilder_written(pb.get());
+}
+
+
+git2pp::pack_builder::pack_builder(repository & r) noexcept : repo(r.repo.get()) {
+	git_packbuilder * result{};
+	git_packbuilder_new(&result, repo);
+	pb.reset(result);
+	threads(0);
+}
@@ -0,0 +1,75 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/pack_indexer.hpp"
+#include "libgit2++/repository.hpp"
+#include <git2/repository.h>
+
+
+void git2pp::pack_indexer_deleter::operator()(git_indexer * idx) const noexcept {
+	git_indexer_free(idx);
+}
+
+
+bool git2pp::pack_indexer::append(const void * data, std::size_t size) noexcept {
+	return !git_indexer_append(idx.get(), data, size, &progress_stats);
+}
+
+bool git2pp::pack_indexer::append(const std::string & data) noexcept {
+	return append(data.data(), data.size());
+}
+
+std::experimental::optional<git_oid> git2pp::pack_indexer::commit() noexcept {
+	if(git_indexer_commit(idx.get(), &progress_stats))
+		return std::experimental::nullopt;
+	else
+		return *git_indexer_hash(idx.get());
+}
+
+const git_transfer_progress & git2pp::pack_indexer::stats() const noexcept {
+	return progress_stats;
+}
+
+
+git2pp::pack_indexer::pack_indexer(repository & repo, const char * path, unsigned int mode, progress_callback progress)
+      : pack_indexer(repo, path ? std::string(path) : std::string(), mode, std::move(progress)) {}
+
+git2pp::pack_indexer::pack_indexer(repository & repo, const std::string & path, unsigned int mode, progress_callback progress) : progress_stats{} {
+	git_odb * result_db{};
+	git_repository_odb(&result_db, repo.repo.get());
+	db.reset(result_db);
+
+	if(progress)
+		progress_func = std::make_unique<progress_callback>(std::move(progress));
+
+	git_indexer * result{};
+	const auto dir = path.empty() ? std::string(git_repository_path(repo.repo.get())) + "objects/pack" : path;
+	git_indexer_new(&result, dir.c_str(), mode, db.get(),
+	                [](const git_transfer_progress * stats, void * payload) {
+		                if(payload)
+			                (*static_cast<progress_callback *>(payload))(*stats);
+		                return 0;
+		              },
+	                progress_func.get());
+	idx.reset(result);
+}
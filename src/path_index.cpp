@@ -0,0 +1,431 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/path_index.hpp"
+#include "libgit2++/commit_tree.hpp"
+#include "libgit2++/commit_view.hpp"
+#include "libgit2++/detail/parallel.hpp"
+#include "libgit2++/detail/scope.hpp"
+#include "libgit2++/detail/sha1.hpp"
+#include "libgit2++/detail/tree_diff.hpp"
+#include "libgit2++/odb.hpp"
+#include "libgit2++/repository.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <git2/graph.h>
+#include <git2/odb.h>
+#include <git2/revwalk.h>
+#include <utility>
+
+
+static const char magic[4]            = {'P', 'I', 'D', 'X'};
+static const std::uint32_t version    = 2;
+static const std::size_t header_size  = 16 + GIT_OID_RAWSZ;
+// Commits diffed between merging their paths in, so a full reindex doesn't hold every commit's at once
+static const std::size_t update_batch = 4096;
+
+
+using changed_path = std::pair<std::string, std::uint64_t>;
+
+
+static bool read_tree_and_parents(git_odb * db, const git_oid & id, git_oid & tree, std::vector<git_oid> & parents);
+static std::uint64_t entry_key(const git_oid & id) noexcept;
+static std::uint32_t read_be32(const unsigned char * data) noexcept;
+static std::uint64_t read_be64(const unsigned char * data) noexcept;
+static void append_be32(std::string & out, std::uint32_t value);
+static void append_be64(std::string & out, std::uint64_t value);
+static bool read_varint(const unsigned char *& data, const unsigned char * end, std::uint32_t & value) noexcept;
+static void append_varint(std::string & out, std::uint32_t value);
+
+
+bool git2pp::path_index::update(const git_oid & tip, std::size_t threads) {
+	if(indexed_tip && !git_oid_cmp(&*indexed_tip, &tip))
+		return true;
+
+	git_odb * db_raw{};
+	if(git_repository_odb(&db_raw, repo))
+		return false;
+	const std::unique_ptr<git_odb, odb_deleter> db(db_raw);
+
+	auto previous_tip         = indexed_tip;
+	const auto previous_count = static_cast<std::uint32_t>(ids.size());
+	const auto rewritten      = previous_tip && git_graph_descendant_of(repo, &tip, &*previous_tip) != 1;
+	if(rewritten)
+		previous_tip = std::experimental::nullopt;
+
+	// Parents before children, so every commit's number is higher than its ancestors'
+	std::vector<git_oid> new_ids;
+	{
+		git_revwalk * walk{};
+		detail::quickscope_wrapper walk_cleanup{[&]() { git_revwalk_free(walk); }};
+		if(git_revwalk_new(&walk, repo))
+			return false;
+		git_revwalk_sorting(walk, GIT_SORT_TOPOLOGICAL | GIT_SORT_REVERSE);
+		if(git_revwalk_push(walk, &tip) || (previous_tip && git_revwalk_hide(walk, &*previous_tip)))
+			return false;
+
+		git_oid id;
+		int err;
+		while(!(err = git_revwalk_next(&id, walk)))
+			new_ids.emplace_back(id);
+		if(err != GIT_ITEROVER)
+			return false;
+	}
+
+
+	// Starting over keeps the old index around until the new one's complete
+	std::vector<oid> old_ids;
+	std::map<std::string, std::vector<change>> old_paths;
+	if(rewritten) {
+		old_ids.swap(ids);
+		old_paths.swap(paths);
+	}
+	const auto restore = [&]() {
+		if(rewritten) {
+			ids.swap(old_ids);
+			paths.swap(old_paths);
+		} else
+			truncate(previous_count);
+	};
+
+	std::vector<std::vector<changed_path>> changed;
+	for(std::size_t batch_begin = 0; batch_begin < new_ids.size(); batch_begin += update_batch) {
+		const auto batch = std::min(update_batch, new_ids.size() - batch_begin);
+		changed.assign(batch, {});
+
+		std::atomic<bool> failed{false};
+		detail::parallel_for(batch, detail::thread_count(batch, threads, 16), [&](auto, auto begin, auto end) {
+			git_oid tree, parent_tree;
+			std::vector<git_oid> parents, grandparents, entries;
+			const auto with_entries = [&](std::vector<std::string> & diff, std::vector<changed_path> & out) {
+				out.clear();
+				for(std::size_t j = 0; j < diff.size(); ++j)
+					out.emplace_back(std::move(diff[j]), entry_key(entries[j]));
+				std::sort(out.begin(), out.end());
+			};
+			for(auto i = begin; i != end && !failed; ++i) {
+				if(!read_tree_and_parents(db.get(), new_ids[batch_begin + i], tree, parents)) {
+					failed = true;
+					break;
+				}
+
+				auto & out = changed[i];
+				if(parents.empty()) {
+					if(auto root = detail::changed_paths(db.get(), nullptr, &tree, 0, &entries))
+						with_entries(*root, out);
+					else
+						failed = true;
+					continue;
+				}
+
+				// Only what differs from every parent
+				for(std::size_t p = 0; p < parents.size() && !failed; ++p) {
+					auto diff = read_tree_and_parents(db.get(), parents[p], parent_tree, grandparents)
+					                ? detail::changed_paths(db.get(), &parent_tree, &tree, 0, p ? nullptr : &entries)
+					                : std::experimental::nullopt;
+					if(!diff) {
+						failed = true;
+						break;
+					}
+
+					if(!p)
+						with_entries(*diff, out);
+					else {
+						std::sort(diff->begin(), diff->end());
+						out.erase(std::remove_if(out.begin(), out.end(),
+						                         [&](auto && path) { return !std::binary_search(diff->begin(), diff->end(), path.first); }),
+						          out.end());
+					}
+					if(out.empty())
+						break;
+				}
+			}
+		});
+		if(failed) {
+			restore();
+			return false;
+		}
+
+		for(std::size_t i = 0; i < batch; ++i) {
+			const auto number = static_cast<std::uint32_t>(ids.size());
+			ids.emplace_back(new_ids[batch_begin + i]);
+			for(auto && path : changed[i])
+				paths[std::move(path.first)].push_back({number, path.second});
+		}
+	}
+
+	indexed_tip = tip;
+	return true;
+}
+
+bool git2pp::path_index::save() const {
+	std::string contents(magic, sizeof(magic));
+	append_be32(contents, version);
+	append_be32(contents, static_cast<std::uint32_t>(ids.size()));
+	append_be32(contents, static_cast<std::uint32_t>(paths.size()));
+	const git_oid zero{};
+	contents.append(reinterpret_cast<const char *>((indexed_tip ? *indexed_tip : zero).id), GIT_OID_RAWSZ);
+
+	for(auto && id : ids)
+		contents.append(reinterpret_cast<const char *>(id.data()), GIT_OID_RAWSZ);
+
+	// Commit numbers are stored as differences from the previous one, which mostly fit in a byte or two
+	for(auto && path : paths) {
+		append_varint(contents, static_cast<std::uint32_t>(path.first.size()));
+		contents += path.first;
+		append_varint(contents, static_cast<std::uint32_t>(path.second.size()));
+		std::uint32_t previous = 0;
+		for(auto && chg : path.second) {
+			append_varint(contents, chg.commit - previous);
+			append_be64(contents, chg.entry);
+			previous = chg.commit;
+		}
+	}
+
+	detail::sha1 checksum;
+	checksum.update(contents.data(), contents.size());
+	const auto trailer = checksum.finish();
+	contents.append(reinterpret_cast<const char *>(trailer.id), GIT_OID_RAWSZ);
+
+
+	// Readers only ever see a complete file
+	const auto lock_path = file_path + ".lock";
+	{
+		std::ofstream out(lock_path, std::ios::binary | std::ios::trunc);
+		if(!out.write(contents.data(), contents.size()) || !out.flush())
+			return false;
+	}
+#ifdef _WIN32
+	std::remove(file_path.c_str());
+#endif
+	return !std::rename(lock_path.c_str(), file_path.c_str());
+}
+
+const std::experimental::optional<git_oid> & git2pp::path_index::tip() const noexcept {
+	return indexed_tip;
+}
+
+std::size_t git2pp::path_index::size() const noexcept {
+	return ids.size();
+}
+
+std::vector<git_oid> git2pp::path_index::history(const std::string & path) const {
+	std::vector<git_oid> result;
+	const auto itr = paths.find(path);
+	if(itr != paths.end())
+		for(auto chg = itr->second.rbegin(); chg != itr->second.rend(); ++chg)
+			result.emplace_back(ids[chg->commit]);
+	return result;
+}
+
+std::experimental::optional<git_oid> git2pp::path_index::last_commit(const std::string & path) const {
+	const auto itr = paths.find(path);
+	if(itr == paths.end())
+		return std::experimental::nullopt;
+
+	// Gone from the tip, or unreadable, matches the commit that removed it
+	git_oid entry{};
+	git_odb * db_raw{};
+	if(!git_repository_odb(&db_raw, repo)) {
+		const std::unique_ptr<git_odb, odb_deleter> db(db_raw);
+		git_oid tree;
+		std::vector<git_oid> parents;
+		std::uint32_t mode;
+		if(!read_tree_and_parents(db.get(), *indexed_tip, tree, parents) || !detail::tree_entry_at(db.get(), tree, path, entry, mode))
+			entry = {};
+	}
+	return static_cast<const git_oid &>(ids[last_change(itr->second, entry)]);
+}
+
+std::vector<std::experimental::optional<git_oid>> git2pp::path_index::last_modified(const commit_tree & tree, const std::string & dir) const {
+	const auto entries = tree.size();
+	std::vector<std::experimental::optional<git_oid>> result(entries);
+
+	auto key                 = dir.empty() ? dir : dir + '/';
+	const auto prefix_length = key.size();
+	for(std::size_t i = 0; i < entries; ++i) {
+		key.resize(prefix_length);
+		key += tree[i].name();
+
+		const auto itr = paths.find(key);
+		if(itr != paths.end())
+			result[i] = static_cast<const git_oid &>(ids[last_change(itr->second, tree[i].id())]);
+	}
+	return result;
+}
+
+
+git2pp::path_index::path_index(repository & r, std::string path) : repo(r.repo.get()), file_path(std::move(path)) {
+	load();
+}
+
+git2pp::path_index::path_index(repository & r) : path_index(r, std::string(git_repository_path(r.repo.get())) + "path-index") {}
+
+
+void git2pp::path_index::load() {
+	std::string contents;
+	{
+		std::ifstream in(file_path, std::ios::binary);
+		if(!in)
+			return;
+		contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+	if(contents.size() < header_size + GIT_OID_RAWSZ || std::memcmp(contents.data(), magic, sizeof(magic)))
+		return;
+
+	const auto data = reinterpret_cast<const unsigned char *>(contents.data());
+	const auto end  = data + contents.size() - GIT_OID_RAWSZ;
+
+	detail::sha1 checksum;
+	checksum.update(data, end - data);
+	const auto expected = checksum.finish();
+	if(std::memcmp(expected.id, end, GIT_OID_RAWSZ) || read_be32(data + 4) != version)
+		return;
+
+	const auto commits    = read_be32(data + 8);
+	const auto path_count = read_be32(data + 12);
+	if(commits > static_cast<std::size_t>(end - data - header_size) / GIT_OID_RAWSZ)
+		return;
+
+	std::vector<oid> loaded_ids;
+	loaded_ids.reserve(commits);
+	auto cur = data + header_size;
+	for(std::uint32_t i = 0; i < commits; ++i, cur += GIT_OID_RAWSZ)
+		loaded_ids.emplace_back(*reinterpret_cast<const git_oid *>(cur));
+
+	// Written sorted, so every path goes in at the end
+	std::map<std::string, std::vector<change>> loaded_paths;
+	for(std::uint32_t i = 0; i < path_count; ++i) {
+		std::uint32_t length, count;
+		if(!read_varint(cur, end, length) || length > static_cast<std::size_t>(end - cur))
+			return;
+		std::string path(reinterpret_cast<const char *>(cur), length);
+		cur += length;
+		if(!read_varint(cur, end, count) || !count || count > commits)
+			return;
+
+		std::vector<change> changes;
+		changes.reserve(count);
+		std::uint32_t number = 0, delta;
+		for(std::uint32_t j = 0; j < count; ++j) {
+			if(!read_varint(cur, end, delta) || delta > commits - number || (j && !delta) || number + delta >= commits || end - cur < 8)
+				return;
+			number += delta;
+			changes.push_back({number, read_be64(cur)});
+			cur += 8;
+		}
+		loaded_paths.emplace_hint(loaded_paths.end(), std::move(path), std::move(changes));
+	}
+	if(cur != end || loaded_paths.size() != path_count)
+		return;
+
+	if(commits)
+		indexed_tip = *reinterpret_cast<const git_oid *>(data + 16);
+	ids   = std::move(loaded_ids);
+	paths = std::move(loaded_paths);
+}
+
+void git2pp::path_index::truncate(std::uint32_t commits) {
+	ids.resize(commits);
+	for(auto itr = paths.begin(); itr != paths.end();) {
+		auto & changes = itr->second;
+		while(!changes.empty() && changes.back().commit >= commits)
+			changes.pop_back();
+		if(changes.empty())
+			itr = paths.erase(itr);
+		else
+			++itr;
+	}
+}
+
+std::uint32_t git2pp::path_index::last_change(const std::vector<change> & changes, const git_oid & entry) noexcept {
+	const auto key = entry_key(entry);
+	for(auto chg = changes.rbegin(); chg != changes.rend(); ++chg)
+		if(chg->entry == key)
+			return chg->commit;
+	return changes.back().commit;
+}
+
+
+static bool read_tree_and_parents(git_odb * db, const git_oid & id, git_oid & tree, std::vector<git_oid> & parents) {
+	git_odb_object * obj{};
+	if(git_odb_read(&obj, db, &id))
+		return false;
+	git2pp::detail::quickscope_wrapper obj_cleanup{[&]() { git_odb_object_free(obj); }};
+
+	const git2pp::commit_view view(static_cast<const char *>(git_odb_object_data(obj)), git_odb_object_size(obj));
+	if(git_odb_object_type(obj) != GIT_OBJ_COMMIT || !view.valid())
+		return false;
+
+	tree                  = view.tree_id();
+	const auto parent_ids = view.parent_ids();
+	parents.assign(parent_ids.begin(), parent_ids.end());
+	return true;
+}
+
+// Enough of an ID to tell apart the few versions one path's been through
+static std::uint64_t entry_key(const git_oid & id) noexcept {
+	return read_be64(id.id);
+}
+
+static std::uint32_t read_be32(const unsigned char * data) noexcept {
+	return (std::uint32_t{data[0]} << 24) | (std::uint32_t{data[1]} << 16) | (std::uint32_t{data[2]} << 8) | std::uint32_t{data[3]};
+}
+
+static std::uint64_t read_be64(const unsigned char * data) noexcept {
+	return (std::uint64_t{read_be32(data)} << 32) | read_be32(data + 4);
+}
+
+static void append_be32(std::string & out, std::uint32_t value) {
+	for(auto shift : {24, 16, 8, 0})
+		out.push_back(static_cast<char>((value >> shift) & 0xFF));
+}
+
+static void append_be64(std::string & out, std::uint64_t value) {
+	append_be32(out, static_cast<std::uint32_t>(value >> 32));
+	append_be32(out, static_cast<std::uint32_t>(value));
+}
+
+static bool read_varint(const unsigned char *& data, const unsigned char * end, std::uint32_t & value) noexcept {
+	value = 0;
+	for(unsigned int shift = 0; shift < 35; shift += 7) {
+		if(data == end)
+			return false;
+		const auto byte = *data++;
+		value |= std::uint32_t{byte & 0x7Fu} << shift;
+		if(!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+static void append_varint(std::string & out, std::uint32_t value) {
+	while(value >= 0x80) {
+		out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	out.push_back(static_cast<char>(value));
+}
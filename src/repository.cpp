@@ -22,17 +22,24 @@
 
 
 #include "libgit2++/repository.hpp"
+#include "libgit2++/detail/parallel.hpp"
 #include "libgit2++/detail/scope.hpp"
 #include "libgit2++/reflog.hpp"
 #include <algorithm>
+#include <cstring>
 #include <git2/blame.h>
 #include <git2/branch.h>
 #include <git2/buffer.h>
+#include <git2/graph.h>
+#include <git2/merge.h>
 #include <git2/object.h>
 #include <git2/tree.h>
 #include <iterator>
 
 
+static std::vector<git_oid> take_oidarray(git_oidarray & array);
+
+
 void git2pp::repository_deleter::operator()(git_repository * repo) const noexcept {
 	if(owning)
 		git_repository_free(repo);
@@ -121,6 +128,12 @@ git2pp::configuration git2pp::repository::config_snapshot() noexcept {
 	return {result};
 }
 
+git2pp::odb git2pp::repository::object_database() noexcept {
+	git_odb * result{};
+	git_repository_odb(&result, repo.get());
+	return {result};
+}
+
 std::string git2pp::repository::message() {
 	git_buf buf{};
 	detail::quickscope_wrapper buf_cleanup{[&]() { git_buf_free(&buf); }};
@@ -148,6 +161,33 @@ git_oid git2pp::repository::hash_file(const std::string & path, object_type type
 	return hash_file(path.c_str(), type, filters ? filters->c_str() : nullptr);
 }
 
+std::vector<git_oid> git2pp::repository::hash_files(const std::vector<std::string> & paths, object_type type, const char * filters, std::size_t threads) {
+	std::vector<git_oid> result(paths.size());
+	detail::parallel_for(paths.size(), detail::thread_count(paths.size(), threads, 64), [&](auto idx, auto begin, auto end) {
+		// Attribute and config caches aren't safe to share, so only the calling thread uses this handle
+		git_repository * handle = repo.get();
+		detail::quickscope_wrapper handle_cleanup{[&]() {
+			if(handle != repo.get())
+				git_repository_free(handle);
+		}};
+		if(idx) {
+			handle = nullptr;
+			if(git_repository_open(&handle, git_repository_path(repo.get())))
+				return;
+			// Setting the one it already has leaks in libgit2, so only an overridden one is copied over
+			const auto workdir = git_repository_workdir(repo.get());
+			const auto opened  = git_repository_workdir(handle);
+			if(workdir && (!opened || std::strcmp(workdir, opened)))
+				git_repository_set_workdir(handle, workdir, false);
+		}
+
+		for(auto i = begin; i != end; ++i)
+			if(git_repository_hashfile(&result[i], handle, paths[i].c_str(), static_cast<git_otype>(type), filters))
+				result[i] = {};
+	});
+	return result;
+}
+
 void git2pp::repository::set_head(const char * path) noexcept {
 	git_repository_set_head(repo.get(), path);
 }
@@ -289,6 +329,7 @@ void git2pp::repository::remove_reference(const std::string & name) noexcept {
 std::vector<std::string> git2pp::repository::reference_names() {
 	git_strarray names;
 	git_reference_list(&names, repo.get());
+	detail::quickscope_wrapper names_cleanup{[&]() { git_strarray_free(&names); }};
 
 	return {names.strings, names.strings + names.count};
 }
@@ -478,6 +519,52 @@ git_oid git2pp::repository::commit_create(const git_signature & author, const gi
 	return commit_create(author, committer, message.c_str(), tree, parents, update_ref, message_encoding);
 }
 
+std::experimental::optional<git_oid> git2pp::repository::merge_base(const git_oid & one, const git_oid & two) noexcept {
+	git_oid result;
+	if(git_merge_base(&result, repo.get(), &one, &two))
+		return {};
+	return result;
+}
+
+std::vector<git_oid> git2pp::repository::merge_bases(const git_oid & one, const git_oid & two) {
+	git_oidarray result{};
+	if(git_merge_bases(&result, repo.get(), &one, &two))
+		return {};
+	return take_oidarray(result);
+}
+
+std::experimental::optional<git_oid> git2pp::repository::merge_base_many(const std::vector<git_oid> & ids) noexcept {
+	git_oid result;
+	if(git_merge_base_many(&result, repo.get(), ids.size(), ids.data()))
+		return {};
+	return result;
+}
+
+std::vector<git_oid> git2pp::repository::merge_bases_many(const std::vector<git_oid> & ids) {
+	git_oidarray result{};
+	if(git_merge_bases_many(&result, repo.get(), ids.size(), ids.data()))
+		return {};
+	return take_oidarray(result);
+}
+
+std::experimental::optional<git_oid> git2pp::repository::merge_base_octopus(const std::vector<git_oid> & ids) noexcept {
+	git_oid result;
+	if(git_merge_base_octopus(&result, repo.get(), ids.size(), ids.data()))
+		return {};
+	return result;
+}
+
+std::experimental::optional<std::pair<std::size_t, std::size_t>> git2pp::repository::ahead_behind(const git_oid & local, const git_oid & upstream) noexcept {
+	std::size_t ahead, behind;
+	if(git_graph_ahead_behind(&ahead, &behind, repo.get(), &local, &upstream))
+		return {};
+	return std::make_pair(ahead, behind);
+}
+
+bool git2pp::repository::descendant_of(const git_oid & descendant, const git_oid & ancestor) noexcept {
+	return git_graph_descendant_of(repo.get(), &descendant, &ancestor) == 1;
+}
+
 git2pp::commit_tree git2pp::repository::tree_lookup(const git_oid & id) noexcept {
 	git_tree * result;
 	git_tree_lookup(&result, repo.get(), &id);
@@ -532,6 +619,16 @@ git_oid git2pp::repository::blob_create_from_disk(const std::string & path) noex
 	return blob_create_from_disk(path.c_str());
 }
 
+git2pp::blob_writer git2pp::repository::blob_create_from_stream(const char * hint_path) noexcept {
+	git_writestream * result{};
+	git_blob_create_fromstream(&result, repo.get(), hint_path);
+	return {result};
+}
+
+git2pp::blob_writer git2pp::repository::blob_create_from_stream(const std::string & hint_path) noexcept {
+	return blob_create_from_stream(hint_path.c_str());
+}
+
 git_oid git2pp::repository::blob_create_from_buffer(const void * buffer, std::size_t length) noexcept {
 	git_oid id;
 
@@ -565,3 +662,9 @@ std::string git2pp::discover_repository(const char * start, const std::string &
 
 	return {buf.ptr, buf.size};
 }
+
+
+static std::vector<git_oid> take_oidarray(git_oidarray & array) {
+	git2pp::detail::quickscope_wrapper array_cleanup{[&]() { git_oidarray_free(&array); }};
+	return {array.ids, array.ids + array.count};
+}
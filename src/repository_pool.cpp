@@ -0,0 +1,227 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/repository_pool.hpp"
+#include "libgit2++/detail/parallel.hpp"
+#include <algorithm>
+#include <exception>
+#include <git2/sys/repository.h>
+#include <iterator>
+#include <utility>
+
+
+git2pp::repository & git2pp::repository_pool::lease::operator*() noexcept {
+	return repo;
+}
+
+git2pp::repository * git2pp::repository_pool::lease::operator->() noexcept {
+	return &repo;
+}
+
+git2pp::repository_pool::lease::lease(lease && other) noexcept : pool(other.pool), repo(std::move(other.repo)) {
+	other.pool = nullptr;
+}
+
+git2pp::repository_pool::lease::~lease() {
+	if(pool)
+		pool->release(std::move(repo));
+}
+
+git2pp::repository_pool::lease::lease(repository_pool & p, repository && r) noexcept : pool(&p), repo(std::move(r)) {}
+
+
+git2pp::repository_pool::lease git2pp::repository_pool::acquire() {
+	if(!valid())
+		return {*this, {nullptr}};
+
+	std::unique_lock<std::mutex> lock(idle_mutex);
+	idle_available.wait(lock, [&]() { return !idle.empty() || !max_handles || opened < max_handles; });
+	if(!idle.empty()) {
+		auto repo = std::move(idle.back());
+		idle.pop_back();
+		return {*this, std::move(repo)};
+	}
+
+	++opened;
+	lock.unlock();
+	auto repo = open();
+	if(!repo.repo) {
+		lock.lock();
+		--opened;
+		lock.unlock();
+		// Whoever's waiting can try opening it instead
+		idle_available.notify_one();
+	}
+	return {*this, std::move(repo)};
+}
+
+bool git2pp::repository_pool::valid() const noexcept {
+	return odb != nullptr;
+}
+
+std::size_t git2pp::repository_pool::size() {
+	std::lock_guard<std::mutex> lock(idle_mutex);
+	return opened;
+}
+
+std::size_t git2pp::repository_pool::capacity() const noexcept {
+	return max_handles;
+}
+
+std::vector<git2pp::object> git2pp::repository_pool::lookup_many(const std::vector<git_oid> & ids, object_type type, std::size_t threads) {
+	return lookup_many_raw<object, git_object>(ids, threads, [&](git_object ** out, git_repository * repo, const git_oid * id) {
+		return git_object_lookup(out, repo, id, static_cast<git_otype>(type));
+	});
+}
+
+std::vector<git2pp::commit> git2pp::repository_pool::commit_lookup_many(const std::vector<git_oid> & ids, std::size_t threads) {
+	return lookup_many_raw<commit, git_commit>(ids, threads, git_commit_lookup);
+}
+
+std::vector<git2pp::commit_tree> git2pp::repository_pool::tree_lookup_many(const std::vector<git_oid> & ids, std::size_t threads) {
+	return lookup_many_raw<commit_tree, git_tree>(ids, threads, git_tree_lookup);
+}
+
+std::vector<git2pp::blob> git2pp::repository_pool::blob_lookup_many(const std::vector<git_oid> & ids, std::size_t threads) {
+	return lookup_many_raw<blob, git_blob>(ids, threads, git_blob_lookup);
+}
+
+
+git2pp::repository_pool::repository_pool(const char * p, std::size_t capacity) : path(p), max_handles(capacity), opened(0), stopping(false) {
+	git_repository * first{};
+	if(git_repository_open(&first, p))
+		return;
+
+	git_odb * result{};
+	if(git_repository_odb(&result, first)) {
+		git_repository_free(first);
+		return;
+	}
+	odb.reset(result);
+
+	idle.push_back({first});
+	opened = 1;
+}
+
+git2pp::repository_pool::repository_pool(const std::string & p, std::size_t capacity) : repository_pool(p.c_str(), capacity) {}
+
+git2pp::repository_pool::~repository_pool() {
+	{
+		std::lock_guard<std::mutex> lock(work_mutex);
+		stopping = true;
+	}
+	work_available.notify_all();
+	for(auto && worker : workers)
+		worker.join();
+}
+
+
+git2pp::repository git2pp::repository_pool::open() noexcept {
+	git_repository * result{};
+	if(git_repository_open(&result, path.c_str()))
+		return {nullptr};
+	git_repository_set_odb(result, odb.get());
+	return {result};
+}
+
+void git2pp::repository_pool::release(repository && repo) {
+	if(!repo.repo)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(idle_mutex);
+		idle.push_back(std::move(repo));
+	}
+	idle_available.notify_one();
+}
+
+void git2pp::repository_pool::dispatch(std::size_t slices, const std::function<void(std::size_t)> & func) {
+	std::vector<std::exception_ptr> errors(slices);
+	const auto run = [&](std::size_t idx) {
+		try {
+			func(idx);
+		} catch(...) {
+			errors[idx] = std::current_exception();
+		}
+	};
+
+	std::mutex done_mutex;
+	std::condition_variable done;
+	auto remaining = slices - 1;
+	{
+		std::lock_guard<std::mutex> lock(work_mutex);
+		while(workers.size() < slices - 1)
+			workers.emplace_back([this]() { work(); });
+		for(std::size_t i = 1; i < slices; ++i)
+			tasks.emplace_back([&, i]() {
+				run(i);
+				std::lock_guard<std::mutex> done_lock(done_mutex);
+				if(!--remaining)
+					done.notify_one();
+			});
+	}
+	work_available.notify_all();
+
+	run(0);
+	{
+		std::unique_lock<std::mutex> lock(done_mutex);
+		done.wait(lock, [&]() { return !remaining; });
+	}
+
+	for(auto && error : errors)
+		if(error)
+			std::rethrow_exception(error);
+}
+
+void git2pp::repository_pool::work() {
+	std::unique_lock<std::mutex> lock(work_mutex);
+	for(;;) {
+		work_available.wait(lock, [&]() { return stopping || !tasks.empty(); });
+		if(tasks.empty())
+			return;
+
+		auto task = std::move(tasks.front());
+		tasks.pop_front();
+		lock.unlock();
+		task();
+		lock.lock();
+	}
+}
+
+template <class T, class R, class F>
+std::vector<T> git2pp::repository_pool::lookup_many_raw(const std::vector<git_oid> & ids, std::size_t threads, F && lookup) {
+	std::vector<R *> raw(ids.size());
+	const auto slices = detail::thread_count(ids.size(), threads ? threads : max_handles, 64);
+	dispatch(slices, [&](std::size_t slice) {
+		auto repo = this->acquire();
+		if(!repo->repo)
+			return;
+		for(auto i = ids.size() * slice / slices; i != ids.size() * (slice + 1) / slices; ++i)
+			lookup(&raw[i], repo->repo.get(), &ids[i]);
+	});
+
+	std::vector<T> result;
+	result.reserve(raw.size());
+	std::transform(raw.begin(), raw.end(), std::back_inserter(result), [](auto r) { return T(r); });
+	return result;
+}
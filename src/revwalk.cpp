@@ -0,0 +1,157 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/revwalk.hpp"
+#include "libgit2++/repository.hpp"
+
+
+void git2pp::revwalk_deleter::operator()(git_revwalk * walk) const noexcept {
+	git_revwalk_free(walk);
+}
+
+
+auto git2pp::revwalk::iterator::operator*() const noexcept -> reference {
+	return current;
+}
+
+auto git2pp::revwalk::iterator::operator->() const noexcept -> pointer {
+	return &current;
+}
+
+auto git2pp::revwalk::iterator::operator++() noexcept -> iterator & {
+	if(git_revwalk_next(&current, walk->walk.get()))
+		walk = nullptr;
+	return *this;
+}
+
+auto git2pp::revwalk::iterator::operator++(int) noexcept -> iterator {
+	auto prev = *this;
+	++*this;
+	return prev;
+}
+
+bool git2pp::revwalk::iterator::operator==(const iterator & other) const noexcept {
+	return walk == other.walk;
+}
+
+bool git2pp::revwalk::iterator::operator!=(const iterator & other) const noexcept {
+	return walk != other.walk;
+}
+
+
+git2pp::revwalk::iterator::iterator(revwalk * w) noexcept : walk(w), current{} {
+	if(walk)
+		++*this;
+}
+
+
+bool git2pp::revwalk::push(const git_oid & id) noexcept {
+	return !git_revwalk_push(walk.get(), &id);
+}
+
+bool git2pp::revwalk::push_ref(const char * refname) noexcept {
+	return !git_revwalk_push_ref(walk.get(), refname);
+}
+
+bool git2pp::revwalk::push_ref(const std::string & refname) noexcept {
+	return push_ref(refname.c_str());
+}
+
+bool git2pp::revwalk::push_glob(const char * glob) noexcept {
+	return !git_revwalk_push_glob(walk.get(), glob);
+}
+
+bool git2pp::revwalk::push_glob(const std::string & glob) noexcept {
+	return push_glob(glob.c_str());
+}
+
+bool git2pp::revwalk::push_head() noexcept {
+	return !git_revwalk_push_head(walk.get());
+}
+
+bool git2pp::revwalk::push_range(const char * range) noexcept {
+	return !git_revwalk_push_range(walk.get(), range);
+}
+
+bool git2pp::revwalk::push_range(const std::string & range) noexcept {
+	return push_range(range.c_str());
+}
+
+bool git2pp::revwalk::hide(const git_oid & id) noexcept {
+	return !git_revwalk_hide(walk.get(), &id);
+}
+
+bool git2pp::revwalk::hide_ref(const char * refname) noexcept {
+	return !git_revwalk_hide_ref(walk.get(), refname);
+}
+
+bool git2pp::revwalk::hide_ref(const std::string & refname) noexcept {
+	return hide_ref(refname.c_str());
+}
+
+bool git2pp::revwalk::hide_glob(const char * glob) noexcept {
+	return !git_revwalk_hide_glob(walk.get(), glob);
+}
+
+bool git2pp::revwalk::hide_glob(const std::string & glob) noexcept {
+	return hide_glob(glob.c_str());
+}
+
+bool git2pp::revwalk::hide_head() noexcept {
+	return !git_revwalk_hide_head(walk.get());
+}
+
+void git2pp::revwalk::sorting(revwalk_sort mode) noexcept {
+	git_revwalk_sorting(walk.get(), static_cast<unsigned int>(mode));
+}
+
+void git2pp::revwalk::simplify_first_parent() noexcept {
+	git_revwalk_simplify_first_parent(walk.get());
+}
+
+void git2pp::revwalk::reset() noexcept {
+	git_revwalk_reset(walk.get());
+}
+
+std::experimental::optional<git_oid> git2pp::revwalk::next() noexcept {
+	git_oid id;
+	if(git_revwalk_next(&id, walk.get()))
+		return std::experimental::nullopt;
+	else
+		return id;
+}
+
+auto git2pp::revwalk::begin() noexcept -> iterator {
+	return {this};
+}
+
+auto git2pp::revwalk::end() noexcept -> iterator {
+	return {nullptr};
+}
+
+
+git2pp::revwalk::revwalk(repository & repo) noexcept {
+	git_revwalk * result{};
+	git_revwalk_new(&result, repo.repo.get());
+	walk.reset(result);
+}
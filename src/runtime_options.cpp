@@ -0,0 +1,92 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/runtime_options.hpp"
+
+
+template <git_libgit2_opt_t option>
+static inline std::size_t get_size() noexcept {
+	std::size_t result{};
+	git_libgit2_opts(option, &result);
+	return result;
+}
+
+
+std::size_t git2pp::runtime_options::mwindow_size() const noexcept {
+	return ::get_size<GIT_OPT_GET_MWINDOW_SIZE>();
+}
+
+void git2pp::runtime_options::mwindow_size(std::size_t size) noexcept {
+	git_libgit2_opts(GIT_OPT_SET_MWINDOW_SIZE, size);
+}
+
+std::size_t git2pp::runtime_options::mwindow_mapped_limit() const noexcept {
+	return ::get_size<GIT_OPT_GET_MWINDOW_MAPPED_LIMIT>();
+}
+
+void git2pp::runtime_options::mwindow_mapped_limit(std::size_t limit) noexcept {
+	git_libgit2_opts(GIT_OPT_SET_MWINDOW_MAPPED_LIMIT, limit);
+}
+
+#if LIBGIT2_VER_MAJOR > 1 || (LIBGIT2_VER_MAJOR == 1 && LIBGIT2_VER_MINOR >= 1)
+std::size_t git2pp::runtime_options::mwindow_file_limit() const noexcept {
+	return ::get_size<GIT_OPT_GET_MWINDOW_FILE_LIMIT>();
+}
+
+void git2pp::runtime_options::mwindow_file_limit(std::size_t limit) noexcept {
+	git_libgit2_opts(GIT_OPT_SET_MWINDOW_FILE_LIMIT, limit);
+}
+#endif
+
+#if LIBGIT2_VER_MAJOR > 0 || LIBGIT2_VER_MINOR >= 28
+std::size_t git2pp::runtime_options::pack_max_objects() const noexcept {
+	return ::get_size<GIT_OPT_GET_PACK_MAX_OBJECTS>();
+}
+
+void git2pp::runtime_options::pack_max_objects(std::size_t objects) noexcept {
+	git_libgit2_opts(GIT_OPT_SET_PACK_MAX_OBJECTS, objects);
+}
+#endif
+
+void git2pp::runtime_options::caching(bool enabled) noexcept {
+	git_libgit2_opts(GIT_OPT_ENABLE_CACHING, static_cast<int>(enabled));
+}
+
+void git2pp::runtime_options::cache_object_limit(object_type type, std::size_t size) noexcept {
+	git_libgit2_opts(GIT_OPT_SET_CACHE_OBJECT_LIMIT, static_cast<git_otype>(type), size);
+}
+
+std::ptrdiff_t git2pp::runtime_options::cache_max_size() const noexcept {
+	return cached_memory().allowed;
+}
+
+void git2pp::runtime_options::cache_max_size(std::ptrdiff_t size) noexcept {
+	git_libgit2_opts(GIT_OPT_SET_CACHE_MAX_SIZE, static_cast<ssize_t>(size));
+}
+
+git2pp::runtime_options::cached_memory_t git2pp::runtime_options::cached_memory() const noexcept {
+	ssize_t current{};
+	ssize_t allowed{};
+	git_libgit2_opts(GIT_OPT_GET_CACHED_MEMORY, &current, &allowed);
+	return {current, allowed};
+}
@@ -0,0 +1,173 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/signature_pool.hpp"
+#include "libgit2++/signature.hpp"
+#include <algorithm>
+#include <functional>
+
+
+static const std::size_t block_size                = 64 * 1024;
+static const git2pp::signature_pool::handle no_entry = 0xFFFFFFFF;
+
+
+git2pp::signature_pool::handle git2pp::signature_pool::intern(std::experimental::string_view name, std::experimental::string_view email) {
+	const auto hash = hash_of(name, email);
+	auto slot       = probe(name, email, hash);
+	if(slots[slot] != no_entry)
+		return slots[slot];
+
+	// Kept at most half full
+	if((entries.size() + 1) * 2 > slots.size()) {
+		rehash(slots.size() * 2);
+		slot = probe(name, email, hash);
+	}
+
+	const auto data = allocate(name.size() + 1 + email.size() + 1);
+	*std::copy(name.begin(), name.end(), data)                     = '\0';
+	*std::copy(email.begin(), email.end(), data + name.size() + 1) = '\0';
+
+	const auto hndl = static_cast<handle>(entries.size());
+	entries.push_back({data, static_cast<std::uint32_t>(name.size()), static_cast<std::uint32_t>(email.size()), hash});
+	slots[slot] = hndl;
+	return hndl;
+}
+
+git2pp::signature_pool::handle git2pp::signature_pool::intern(const git_signature & sig) {
+	return intern(sig.name, sig.email);
+}
+
+git2pp::signature_pool::handle git2pp::signature_pool::intern(const signature & sig) {
+	return intern(sig.name, sig.email);
+}
+
+git2pp::signature_pool::handle git2pp::signature_pool::intern_raw(std::experimental::string_view sig) {
+	auto email_start = sig.find('<');
+	auto email_end   = sig.rfind('>');
+	if(email_start == std::experimental::string_view::npos || email_end == std::experimental::string_view::npos || email_end < email_start)
+		email_start = email_end = sig.size();
+
+	auto name = sig.substr(0, email_start);
+	while(!name.empty() && name.back() == ' ')
+		name.remove_suffix(1);
+	return intern(name, email_start == email_end ? std::experimental::string_view{} : sig.substr(email_start + 1, email_end - email_start - 1));
+}
+
+std::experimental::optional<git2pp::signature_pool::handle> git2pp::signature_pool::find(std::experimental::string_view name,
+                                                                                         std::experimental::string_view email) const noexcept {
+	const auto hndl = slots[probe(name, email, hash_of(name, email))];
+	if(hndl == no_entry)
+		return {};
+	return hndl;
+}
+
+std::experimental::string_view git2pp::signature_pool::name(handle hndl) const noexcept {
+	const auto & ent = entries[hndl];
+	return {ent.name, ent.name_size};
+}
+
+std::experimental::string_view git2pp::signature_pool::email(handle hndl) const noexcept {
+	const auto & ent = entries[hndl];
+	return {ent.name + ent.name_size + 1, ent.email_size};
+}
+
+git_signature git2pp::signature_pool::to_signature(handle hndl, git_time when) const noexcept {
+	const auto & ent = entries[hndl];
+	return {const_cast<char *>(ent.name), const_cast<char *>(ent.name + ent.name_size + 1), when};
+}
+
+std::vector<git2pp::signature_pool::handle> git2pp::signature_pool::merge(const signature_pool & other) {
+	std::vector<handle> result;
+	result.reserve(other.size());
+	for(handle hndl = 0; hndl < other.size(); ++hndl)
+		result.emplace_back(intern(other.name(hndl), other.email(hndl)));
+	return result;
+}
+
+std::size_t git2pp::signature_pool::size() const noexcept {
+	return entries.size();
+}
+
+std::size_t git2pp::signature_pool::arena_size() const noexcept {
+	return used_bytes;
+}
+
+void git2pp::signature_pool::clear() noexcept {
+	entries.clear();
+	std::fill(slots.begin(), slots.end(), no_entry);
+	blocks.clear();
+	block_free = nullptr;
+	block_left = 0;
+	used_bytes = 0;
+}
+
+git2pp::signature_pool::signature_pool() : slots(16, no_entry), block_free(nullptr), block_left(0), used_bytes(0) {}
+
+
+std::size_t git2pp::signature_pool::hash_of(std::experimental::string_view name, std::experimental::string_view email) noexcept {
+	const std::hash<std::experimental::string_view> hasher;
+	return hasher(name) * 31 ^ hasher(email);
+}
+
+std::size_t git2pp::signature_pool::probe(std::experimental::string_view name, std::experimental::string_view email, std::size_t hash) const noexcept {
+	const auto mask = slots.size() - 1;
+	for(auto slot = hash & mask;; slot = (slot + 1) & mask) {
+		const auto hndl = slots[slot];
+		if(hndl == no_entry)
+			return slot;
+
+		const auto & ent = entries[hndl];
+		if(ent.hash == hash && name == this->name(hndl) && email == this->email(hndl))
+			return slot;
+	}
+}
+
+void git2pp::signature_pool::rehash(std::size_t capacity) {
+	slots.assign(capacity, no_entry);
+	const auto mask = capacity - 1;
+	for(handle hndl = 0; hndl < entries.size(); ++hndl) {
+		auto slot = entries[hndl].hash & mask;
+		while(slots[slot] != no_entry)
+			slot = (slot + 1) & mask;
+		slots[slot] = hndl;
+	}
+}
+
+// Anything bigger than a block gets one of its own, so the current block isn't wasted
+char * git2pp::signature_pool::allocate(std::size_t size) {
+	used_bytes += size;
+	if(size > block_size / 4) {
+		blocks.emplace_back(new char[size]);
+		return blocks.back().get();
+	}
+
+	if(size > block_left) {
+		blocks.emplace_back(new char[block_size]);
+		block_free = blocks.back().get();
+		block_left = block_size;
+	}
+	const auto result = block_free;
+	block_free += size;
+	block_left -= size;
+	return result;
+}
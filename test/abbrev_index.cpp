@@ -0,0 +1,61 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/abbrev_index.hpp"
+#include "libgit2++/repository.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+#include <string>
+#include <vector>
+
+
+TEST_CASE("resolve_prefix() - shortest_unique_abbrev() round-trip", "[abbrev_index]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/abbrev_index/resolve_prefix()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	std::vector<git2pp::oid> ids;
+	for(auto i = 0; i < 300; ++i)
+		ids.emplace_back(repo.blob_create_from_buffer("blob " + std::to_string(i)));
+
+	git2pp::abbrev_index index(repo);
+	REQUIRE(index.size() == ids.size());
+
+	const auto lengths = index.shortest_unique_abbrevs(ids, 1);
+	for(std::size_t i = 0; i < ids.size(); ++i) {
+		const auto hex = ids[i].str();
+		CHECK(*index.resolve_prefix(hex) == ids[i]);
+		CHECK(*index.resolve_prefix(hex.substr(0, lengths[i])) == ids[i]);
+		CHECK_FALSE(index.resolve_prefix(hex.substr(0, lengths[i] - 1)));
+	}
+	CHECK(index.abbreviate(ids[0]).size() >= 7);
+
+	CHECK_FALSE(index.resolve_prefix(""));
+	CHECK_FALSE(index.resolve_prefix("xyz"));
+	CHECK_FALSE(index.resolve_prefix(std::string(41, '0')));
+
+	const auto added = repo.blob_create_from_buffer("added");
+	CHECK_FALSE(index.resolve_prefix(git2pp::oid(added).str()));
+	index.insert(added);
+	CHECK(index.resolve_prefix(git2pp::oid(added).str()));
+}
@@ -0,0 +1,72 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/blob.hpp"
+#include "libgit2++/buffer.hpp"
+#include "libgit2++/repository.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+#include <string>
+
+
+using namespace std::literals;
+
+
+TEST_CASE("content()", "[blob]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/blob/content()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const auto blb = repo.blob_lookup(repo.blob_create_from_buffer("content\nwith\0nul"s));
+	CHECK(blb.content() == "content\nwith\0nul"s);
+	CHECK(blb.content().data() == blb.raw().first);
+}
+
+TEST_CASE("filtered_into() - buffer is reused", "[blob]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/blob/filtered_into()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	auto first  = repo.blob_lookup(repo.blob_create_from_buffer("first\n"));
+	auto second = repo.blob_lookup(repo.blob_create_from_buffer("second\n"));
+
+	git2pp::buffer buf;
+	REQUIRE(buf.reserve(64));
+	const auto data     = buf.data();
+	const auto capacity = buf.capacity();
+
+	REQUIRE(first.filtered_into(buf, "first.txt"));
+	CHECK(buf.view() == first.filtered("first.txt"));
+	CHECK(buf.data() == data);
+	CHECK(buf.capacity() == capacity);
+
+	REQUIRE(second.filtered_into(buf, "second.txt"));
+	CHECK(buf.str() == second.filtered("second.txt"));
+	CHECK(buf.data() == data);
+	CHECK(buf.capacity() == capacity);
+
+	REQUIRE(first.filtered_into(buf, "first.txt"));
+	CHECK(buf.view() == "first\n");
+	CHECK(buf.data() == data);
+	CHECK(buf.capacity() == capacity);
+}
@@ -0,0 +1,187 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/commit_graph.hpp"
+#include "libgit2++/oid.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+//   a - c - e - m
+//   |    \     /|
+//   |     d --- |
+//   b ---------/
+TEST_CASE("write() - read back", "[commit_graph]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/commit_graph/write()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const auto a = commit_files(repo, {{"file", "a"}}, {}, 1500000000);
+	const auto b = commit_files(repo, {{"file", "b"}}, {a}, 1500000001, "refs/heads/b");
+	const auto c = commit_files(repo, {{"file", "c"}}, {a}, 1500000002);
+	const auto d = commit_files(repo, {{"file", "d"}}, {c}, 1500000003);
+	const auto e = commit_files(repo, {{"file", "e"}}, {c}, 1500000004);
+	const auto m = commit_files(repo, {{"file", "m"}}, {e, b, d}, 1500000005, "refs/heads/master");
+	const auto lone = commit_files(repo, {{"file", "lone"}}, {}, 1499999999, "refs/heads/lone");
+
+	REQUIRE(git2pp::commit_graph::write(repo, 2));
+	const git2pp::commit_graph graph(repo);
+	REQUIRE(graph.valid());
+	CHECK(graph.verify());
+	REQUIRE(graph.size() == 7);
+
+	const auto pos = [&](const git_oid & id) { return *graph.position(id); };
+	CHECK(git2pp::oid(graph.id(pos(m))) == m);
+	CHECK(graph.parents(pos(m)) == (std::vector<std::uint32_t>{pos(e), pos(b), pos(d)}));
+	CHECK(graph.parents(pos(d)) == std::vector<std::uint32_t>{pos(c)});
+	CHECK(graph.parent_count(pos(a)) == 0);
+	CHECK(git2pp::oid(graph.tree_id(pos(m))) == repo.commit_lookup(m).tree_id());
+
+	CHECK(graph.generation(pos(a)) == 1);
+	CHECK(graph.generation(pos(b)) == 2);
+	CHECK(graph.generation(pos(e)) == 3);
+	CHECK(graph.generation(pos(m)) == 4);
+	CHECK(graph.generation(pos(lone)) == 1);
+	CHECK(graph.time(pos(m)) == 1500000005);
+
+	CHECK(graph.is_ancestor(a, m));
+	CHECK(graph.is_ancestor(d, m));
+	CHECK(graph.is_ancestor(m, m));
+	CHECK_FALSE(graph.is_ancestor(m, a));
+	CHECK_FALSE(graph.is_ancestor(b, d));
+	CHECK_FALSE(graph.is_ancestor(lone, m));
+
+	git_oid missing{};
+	CHECK_FALSE(graph.position(missing));
+	CHECK_FALSE(git2pp::commit_graph(dir + "/nonexistant").valid());
+}
+
+TEST_CASE("valid() - malformed files are rejected", "[commit_graph]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/commit_graph/valid()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const auto a = commit_files(repo, {{"file", "a"}}, {}, 1500000000);
+	const auto b = commit_files(repo, {{"file", "b"}}, {a}, 1500000001);
+	const auto c = commit_files(repo, {{"file", "c"}}, {a}, 1500000002);
+	commit_files(repo, {{"file", "m"}}, {a, b, c}, 1500000003, "refs/heads/master");
+
+	const auto path = dir + "/.git/objects/info/commit-graph";
+	REQUIRE(git2pp::commit_graph::write(repo));
+	std::ifstream in(path, std::ios::binary);
+	const std::string original(std::istreambuf_iterator<char>(in), {});
+	REQUIRE(git2pp::commit_graph(path).valid());
+
+	const auto chunk = [&](const char * id) {
+		for(std::size_t entry = 8; entry + 12 <= original.size(); entry += 12)
+			if(!original.compare(entry, 4, id, 4)) {
+				std::size_t offset = 0;
+				for(auto i = 4u; i < 12; ++i)
+					offset = (offset << 8) | static_cast<unsigned char>(original[entry + i]);
+				return offset;
+			}
+		return std::string::npos;
+	};
+	const auto valid_with = [&](std::size_t offset, unsigned char byte) {
+		auto contents    = original;
+		contents[offset] = static_cast<char>(byte);
+		const auto damaged = dir + "/damaged-graph";
+		std::ofstream(damaged, std::ios::binary | std::ios::trunc) << contents;
+		return git2pp::commit_graph(damaged).valid();
+	};
+
+	REQUIRE(chunk("CDAT") != std::string::npos);
+	REQUIRE(chunk("EDGE") != std::string::npos);
+	CHECK(valid_with(0, 'C'));
+	// Base graph count, making it a split graph
+	CHECK_FALSE(valid_with(7, 1));
+	// First parent of the first commit, past every commit there is
+	CHECK_FALSE(valid_with(chunk("CDAT") + 20, 0x10));
+	// The merge's second and third parents are the only extra edges, so clearing the third's end marker leaves the list running off the chunk
+	CHECK_FALSE(valid_with(chunk("EDGE") + 4, 0x00));
+}
+
+//   a - b - c - m
+//    \       /
+//     d --- e - f
+TEST_CASE("ahead_behind()", "[commit_graph]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/commit_graph/ahead_behind()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const auto a    = commit_files(repo, {{"file", "a"}}, {}, 1500000000);
+	const auto b    = commit_files(repo, {{"file", "b"}}, {a}, 1500000001);
+	const auto c    = commit_files(repo, {{"file", "c"}}, {b}, 1500000002);
+	const auto d    = commit_files(repo, {{"file", "d"}}, {a}, 1500000003);
+	const auto e    = commit_files(repo, {{"file", "e"}}, {d}, 1500000004, "refs/heads/e");
+	const auto f    = commit_files(repo, {{"file", "f"}}, {e}, 1500000005, "refs/heads/f");
+	const auto m    = commit_files(repo, {{"file", "m"}}, {c, e}, 1500000006, "refs/heads/master");
+	const auto lone = commit_files(repo, {{"file", "lone"}}, {}, 1500000007, "refs/heads/lone");
+
+	REQUIRE(git2pp::commit_graph::write(repo));
+	const git2pp::commit_graph graph(repo);
+	REQUIRE(graph.valid());
+
+	git_oid missing{};
+	// Enough tips for more than one walk
+	std::vector<git_oid> tips{f, e, c, m, lone, missing, a};
+	for(auto i = 0; i < 100; ++i)
+		tips.emplace_back(i % 2 ? f : c);
+
+	const auto result = graph.ahead_behind(m, tips, 2);
+	REQUIRE(result.size() == tips.size());
+	const auto check = [&](std::size_t idx, std::size_t ahead, std::size_t behind, const git_oid & base) {
+		INFO(idx);
+		REQUIRE(result[idx]);
+		CHECK(result[idx]->ahead == ahead);
+		CHECK(result[idx]->behind == behind);
+		REQUIRE(result[idx]->merge_base);
+		CHECK(git2pp::oid(graph.id(*result[idx]->merge_base)) == base);
+	};
+	check(0, 1, 3, e);
+	check(1, 0, 3, e);
+	check(2, 0, 3, c);
+	check(3, 0, 0, m);
+	check(6, 0, 5, a);
+	for(auto i = 7u; i < tips.size(); ++i)
+		if((i - 7) % 2)
+			check(i, 1, 3, e);
+		else
+			check(i, 0, 3, c);
+
+	REQUIRE(result[4]);
+	CHECK(result[4]->ahead == 1);
+	CHECK(result[4]->behind == 6);
+	CHECK_FALSE(result[4]->merge_base);
+	CHECK_FALSE(result[5]);
+
+	CHECK_FALSE(graph.ahead_behind(missing, tips)[0]);
+	const auto single = graph.ahead_behind(*graph.position(m), *graph.position(f));
+	CHECK(single.ahead == 1);
+	CHECK(single.behind == 3);
+}
@@ -0,0 +1,97 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/commit_view.hpp"
+#include "libgit2++/oid.hpp"
+#include "catch.hpp"
+#include <string>
+#include <vector>
+
+
+using namespace git2pp::literals;
+
+
+static const std::string merge_commit = "tree 4b825dc642cb6eb9a060e54bf8d69288fbee4904\n"
+                                        "parent 0123456789abcdef0123456789abcdef01234567\n"
+                                        "parent 89abcdef0123456789abcdef0123456789abcdef\n"
+                                        "author A U Thor <author@example.com> 1500000000 +0200\n"
+                                        "committer C O Mitter <committer@example.com> 1500000042 -0130\n"
+                                        "encoding ISO-8859-1\n"
+                                        "\n"
+                                        "Subject\n"
+                                        "\n"
+                                        "Body\n";
+
+
+TEST_CASE("commit_view - merge", "[commit_view]") {
+	const git2pp::commit_view view(merge_commit);
+	REQUIRE(view.valid());
+	CHECK(git2pp::oid(view.tree_id()) == "4b825dc642cb6eb9a060e54bf8d69288fbee4904"_oid);
+
+	std::vector<git2pp::oid> parents;
+	for(auto && parent : view.parent_ids())
+		parents.emplace_back(parent);
+	CHECK(parents == (std::vector<git2pp::oid>{"0123456789abcdef0123456789abcdef01234567"_oid, "89abcdef0123456789abcdef0123456789abcdef"_oid}));
+	CHECK(view.parent_count() == 2);
+	CHECK(git2pp::oid(*view.parent_id(1)) == "89abcdef0123456789abcdef0123456789abcdef"_oid);
+	CHECK_FALSE(view.parent_id(2));
+
+	CHECK(view.time() == 1500000042);
+	CHECK(view.time_offset() == -90);
+	CHECK(view.author() == "A U Thor <author@example.com> 1500000000 +0200");
+	CHECK(view.committer() == "C O Mitter <committer@example.com> 1500000042 -0130");
+	CHECK(view.header("encoding") == "ISO-8859-1");
+	CHECK(view.header("gpgsig").empty());
+	CHECK(view.message() == "Subject\n\nBody\n");
+	CHECK(view.raw().size() == merge_commit.size());
+}
+
+TEST_CASE("commit_view - root", "[commit_view]") {
+	const std::string raw = "tree 4b825dc642cb6eb9a060e54bf8d69288fbee4904\n"
+	                        "author Name <a> 1 +0000\n"
+	                        "committer Name > with > brackets <c> 7 +0000\n"
+	                        "\n"
+	                        "Message";
+	const git2pp::commit_view view(raw);
+	REQUIRE(view.valid());
+	CHECK(view.parent_count() == 0);
+	CHECK(view.parent_ids().begin() == view.parent_ids().end());
+	CHECK(view.time() == 7);
+	CHECK(view.message() == "Message");
+}
+
+TEST_CASE("commit_view - malformed", "[commit_view]") {
+	CHECK_FALSE(git2pp::commit_view().valid());
+	CHECK_FALSE(git2pp::commit_view(merge_commit.substr(0, 20)).valid());
+	CHECK(git2pp::commit_view(merge_commit.substr(0, 20)).parent_count() == 0);
+	CHECK(git2pp::commit_view(merge_commit.substr(0, 20)).time() == 0);
+	CHECK_FALSE(git2pp::commit_view("tree zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz\n").valid());
+
+	// Cut off mid-header: no committer, no message, parents up to the cut
+	const auto truncated_raw = merge_commit.substr(0, 100);
+	const git2pp::commit_view truncated(truncated_raw);
+	REQUIRE(truncated.valid());
+	CHECK(truncated.parent_count() == 1);
+	CHECK(truncated.time() == 0);
+	CHECK(truncated.message().empty());
+}
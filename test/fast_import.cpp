@@ -0,0 +1,181 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/fast_import.hpp"
+#include "libgit2++/oid.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+#include <sstream>
+#include <string>
+
+
+TEST_CASE("fast_import", "[fast_import]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/fast_import/fast_import/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	// The same commits commit_files() makes, so they have to come out with the same IDs
+	const auto a = commit_files(repo, {{"dir/file", "1"}, {"dir/sub/deep", "2"}, {"other", "3"}}, {}, 1500000000);
+	const auto b = commit_files(repo, {{"moved/file", "1"}, {"moved/sub/deep", "2"}, {"other", "4"}, {"copy", "3"}}, {a}, 1500000001);
+	const auto c = commit_files(repo, {{"other", "5"}}, {b}, 1500000002);
+
+	char name[]     = "Test";
+	char email[]    = "test@test.localhost";
+	const auto sig  = [&](git_time_t time) { return git_signature{name, email, {time, 0}}; };
+	const auto body = [](git_time_t time) { return "Commit at " + std::to_string(time) + '\n'; };
+
+	git2pp::fast_import import(repo);
+	import.file_modify("dir/file", import.blob("1"));
+	import.file_modify("dir/sub/deep", import.blob("2"));
+	import.file_modify("other", import.blob("3"));
+	CHECK(git2pp::oid(import.commit("refs/heads/master", sig(1500000000), sig(1500000000), body(1500000000))) == a);
+
+	import.file_copy("other", "copy");
+	import.file_rename("dir", "moved");
+	import.file_modify("other", import.blob("4"));
+	import.file_delete("nonexistant");
+	CHECK(git2pp::oid(import.commit("refs/heads/master", sig(1500000001), sig(1500000001), body(1500000001))) == b);
+
+	import.file_delete_all();
+	import.file_modify("other", import.blob("5"));
+	CHECK(git2pp::oid(import.commit("refs/heads/master", sig(1500000002), sig(1500000002), body(1500000002))) == c);
+
+	REQUIRE(import.tip("refs/heads/master"));
+	CHECK(git2pp::oid(*import.tip("refs/heads/master")) == c);
+	CHECK(repo.reference_names().empty());
+
+	REQUIRE(import.finish());
+	CHECK(git2pp::oid(repo.lookup_id("refs/heads/master")) == c);
+
+	// Nothing to rename
+	import.file_rename("nonexistant", "elsewhere");
+	CHECK(git2pp::oid(import.commit("refs/heads/master", sig(1500000003), sig(1500000003), body(1500000003))).zero());
+	CHECK_FALSE(import.finish());
+	CHECK(git2pp::oid(repo.lookup_id("refs/heads/master")) == c);
+}
+
+TEST_CASE("fast_import - parse()", "[fast_import]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/fast_import/parse()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	std::istringstream stream("blob\n"
+	                          "mark :1\n"
+	                          "data 5\n"
+	                          "first\n"
+	                          "commit refs/heads/master\n"
+	                          "mark :2\n"
+	                          "author Author <author@example.com> 1500000000 +0100\n"
+	                          "committer Committer <committer@example.com> 1500000060 -0230\n"
+	                          "data <<EOF\n"
+	                          "Message\n"
+	                          "EOF\n"
+	                          "M 100644 :1 \"dir/with space\"\n"
+	                          "M 755 inline run.sh\n"
+	                          "data 3\n"
+	                          "sh\n"
+	                          "\n"
+	                          "commit refs/heads/side\n"
+	                          "committer Committer <committer@example.com> 1500000120 +0000\n"
+	                          "data 5\n"
+	                          "side\n"
+	                          "from :2\n"
+	                          "D run.sh\n"
+	                          "\n"
+	                          "commit refs/heads/master\n"
+	                          "committer Committer <committer@example.com> 1500000180 +0000\n"
+	                          "data 6\n"
+	                          "merge\n"
+	                          "merge refs/heads/side\n"
+	                          "M 100644 inline new\n"
+	                          "data 0\n"
+	                          "\n"
+	                          "done\n");
+	{
+		git2pp::fast_import import(repo, 2);
+		REQUIRE(import.parse(stream));
+		REQUIRE(import.finish());
+	}
+
+	auto reopened    = git2pp::repository::open(dir);
+	const auto merge = reopened.commit_lookup(reopened.lookup_id("refs/heads/master"));
+	const auto side  = reopened.commit_lookup(reopened.lookup_id("refs/heads/side"));
+	REQUIRE(merge.parent_amount() == 2);
+	CHECK(git2pp::oid(*merge.parent_id(1)) == git2pp::oid(side.id()));
+	CHECK(merge.message() == std::string("merge\n"));
+
+	const auto first = merge.parent(0);
+	CHECK(first.message() == std::string("Message\n"));
+	CHECK(first.author().name == std::string("Author"));
+	CHECK(first.author().when.offset == 60);
+	CHECK(first.committer().when.offset == -150);
+	CHECK(git2pp::oid(*side.parent_id(0)) == git2pp::oid(first.id()));
+
+	const auto tree = merge.tree();
+	CHECK(tree.size() == 3);
+	CHECK(git2pp::oid(tree.at_path("dir/with space").id()) == git2pp::oid(reopened.blob_create_from_buffer("first")));
+	CHECK(tree.at_path("run.sh").file_mode() == git2pp::filemode::blob_executable);
+	CHECK(git2pp::oid(tree.at_path("new").id()) == git2pp::oid(reopened.blob_create_from_buffer("")));
+	CHECK(side.tree().size() == 1);
+}
+
+TEST_CASE("fast_import - finish() only fast-forwards", "[fast_import]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/fast_import/finish()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const auto base = commit_files(repo, {{"file", "base"}}, {}, 1500000000, "refs/heads/master");
+	repo.make_reference("refs/tags/blob", repo.blob_create_from_buffer("tagged"), "Tag a blob");
+
+	char name[]    = "Test";
+	char email[]   = "test@test.localhost";
+	const auto sig = git_signature{name, email, {1500000001, 0}};
+
+	git2pp::fast_import import(repo);
+	// Starts from master, so moving it is a fast-forward
+	import.file_modify("file", import.blob("next"));
+	const auto next = import.commit("refs/heads/master", sig, sig, "Next\n");
+	REQUIRE(import.finish());
+	CHECK(git2pp::oid(repo.lookup_id("refs/heads/master")) == next);
+	REQUIRE(repo.commit_lookup(next).parent_amount() == 1);
+	CHECK(git2pp::oid(*repo.commit_lookup(next).parent_id(0)) == base);
+
+	// Nothing to start from in a blob, so that branch starts over instead of failing the import
+	import.file_modify("file", import.blob("over"));
+	const auto over = import.commit("refs/tags/blob", sig, sig, "Over\n");
+	REQUIRE_FALSE(git2pp::oid(over).zero());
+
+	import.reset("refs/heads/master");
+	import.file_modify("file", import.blob("rewritten"));
+	const auto rewritten = import.commit("refs/heads/master", sig, sig, "Rewritten\n");
+	REQUIRE_FALSE(git2pp::oid(rewritten).zero());
+
+	CHECK_FALSE(import.finish());
+	CHECK(git2pp::oid(repo.lookup_id("refs/heads/master")) == next);
+	CHECK(git2pp::oid(repo.lookup_id("refs/tags/blob")) != over);
+
+	REQUIRE(import.finish(true));
+	CHECK(git2pp::oid(repo.lookup_id("refs/heads/master")) == rewritten);
+	CHECK(git2pp::oid(repo.lookup_id("refs/tags/blob")) == over);
+	CHECK(repo.commit_lookup(over).parent_amount() == 0);
+}
@@ -0,0 +1,84 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/file_history.hpp"
+#include "libgit2++/commit_graph.hpp"
+#include "libgit2++/oid.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+#include <string>
+#include <vector>
+
+
+static std::vector<git2pp::oid> walk_history(git2pp::file_history & history, std::vector<std::string> * paths = nullptr);
+
+
+//   a - b - c - d - e, "dir/file" renamed to "moved" in d
+TEST_CASE("file_history", "[file_history]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/file_history/file_history/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const std::string content(1000, 'x');
+	const auto a = commit_files(repo, {{"dir/file", content + "1"}, {"other", "1"}}, {}, 1500000000);
+	const auto b = commit_files(repo, {{"dir/file", content + "2"}, {"other", "1"}}, {a}, 1500000001);
+	const auto c = commit_files(repo, {{"dir/file", content + "2"}, {"other", "2"}}, {b}, 1500000002);
+	const auto d = commit_files(repo, {{"moved", content + "2"}, {"other", "2"}}, {c}, 1500000003);
+	const auto e = commit_files(repo, {{"moved", content + "3"}, {"other", "2"}}, {d}, 1500000004, "refs/heads/master");
+
+	REQUIRE(git2pp::commit_graph::write(repo, 0, true));
+	const git2pp::commit_graph graph(repo);
+	REQUIRE(graph.has_changed_paths());
+	CHECK(graph.maybe_changed(*graph.position(b), "dir/file"));
+	CHECK(graph.maybe_changed(*graph.position(b), "dir"));
+	CHECK(graph.maybe_changed(*graph.position(a), "other"));
+	CHECK_FALSE(graph.maybe_changed(*graph.position(c), "dir/file"));
+
+	for(auto graph_ptr : {static_cast<const git2pp::commit_graph *>(nullptr), &graph}) {
+		INFO(graph_ptr);
+		git2pp::file_history moved(repo, e, "moved", false, graph_ptr);
+		CHECK(walk_history(moved) == (std::vector<git2pp::oid>{e, d}));
+
+		git2pp::file_history in_dir(repo, e, "dir", false, graph_ptr);
+		CHECK(walk_history(in_dir) == (std::vector<git2pp::oid>{d, b, a}));
+
+		std::vector<std::string> paths;
+		git2pp::file_history followed(repo, e, "moved", true, graph_ptr);
+		CHECK(walk_history(followed, &paths) == (std::vector<git2pp::oid>{e, d, b, a}));
+		CHECK(paths == (std::vector<std::string>{"moved", "moved", "dir/file", "dir/file"}));
+
+		git2pp::file_history missing(repo, e, "nonexistant", true, graph_ptr);
+		CHECK(walk_history(missing).empty());
+	}
+}
+
+
+static std::vector<git2pp::oid> walk_history(git2pp::file_history & history, std::vector<std::string> * paths) {
+	std::vector<git2pp::oid> result;
+	for(auto && id : history) {
+		result.emplace_back(id);
+		if(paths)
+			paths->emplace_back(history.path());
+	}
+	return result;
+}
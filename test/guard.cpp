@@ -0,0 +1,50 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/guard.hpp"
+#include "catch.hpp"
+
+
+TEST_CASE("runtime::active() - lifetime", "[guard]") {
+	CHECK_FALSE(git2pp::runtime::active());
+	{
+		git2pp::runtime rt;
+		CHECK(git2pp::runtime::active());
+		{
+			const auto other = rt;
+			CHECK(git2pp::runtime::active());
+		}
+		CHECK(git2pp::runtime::active());
+	}
+	CHECK_FALSE(git2pp::runtime::active());
+}
+
+TEST_CASE("guard - outliving runtime", "[guard]") {
+	git2pp::guard grd;
+	{
+		git2pp::runtime rt;
+		git2pp::guard inner;
+		const auto copy = grd;
+	}
+	CHECK_FALSE(git2pp::runtime::active());
+}
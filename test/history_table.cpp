@@ -0,0 +1,76 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/history_table.hpp"
+#include "libgit2++/oid.hpp"
+#include "libgit2++/revwalk.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+#include <vector>
+
+
+TEST_CASE("history_table", "[history_table]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/history_table/history_table/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	// Long enough to be split across threads, with a merge every 100 commits
+	std::vector<git_oid> ids{commit_files(repo, {{"file", "0"}}, {}, 1500000000)};
+	const auto side = commit_files(repo, {{"side", "side"}}, {}, 1500000000);
+	for(auto i = 1; i < 600; ++i) {
+		std::vector<git_oid> parents{ids.back()};
+		if(i % 100 == 0)
+			parents.emplace_back(side);
+		ids.emplace_back(commit_files(repo, {{"file", std::to_string(i)}}, parents, 1500000000 + i));
+	}
+	repo.make_reference("refs/heads/master", ids.back(), "history_table test");
+
+	git2pp::revwalk walk(repo);
+	walk.sorting(git2pp::revwalk_sort::topological | git2pp::revwalk_sort::time);
+	REQUIRE(walk.push_head());
+	const git2pp::history_table table(repo, walk, 4);
+
+	REQUIRE(table.size() == ids.size() + 1);
+	REQUIRE(table.parent_offsets.size() == table.size() + 1);
+	CHECK(table.parent_offsets.back() == ids.size() - 1 + 5);
+	CHECK(table.parent_ids.size() == table.parent_offsets.back());
+	REQUIRE(table.people.size() == 1);
+	CHECK(table.people.name(0) == "Test");
+	CHECK(table.people.email(0) == "test@test.localhost");
+
+	for(std::size_t row = 0; row + 2 < table.size(); ++row) {
+		INFO(row);
+		const auto i = ids.size() - 1 - row;
+		CHECK(git2pp::oid(table.ids[row]) == ids[i]);
+		CHECK(git2pp::oid(table.tree_ids[row]) == repo.commit_lookup(ids[i]).tree_id());
+		CHECK(table.times[row] == 1500000000 + static_cast<std::int64_t>(i));
+		CHECK(table.time_offsets[row] == 0);
+		CHECK(table.authors[row] == 0);
+		CHECK(table.committers[row] == 0);
+		REQUIRE(table.parent_offsets[row + 1] - table.parent_offsets[row] == (i % 100 ? 1u : 2u));
+		CHECK(git2pp::oid(table.parent_ids[table.parent_offsets[row]]) == ids[i - 1]);
+	}
+
+	// Walk already drained
+	CHECK(git2pp::history_table(repo, walk).size() == 0);
+}
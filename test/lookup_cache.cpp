@@ -0,0 +1,63 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/lookup_cache.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+
+
+TEST_CASE("commit_lookup() - hits, misses and evictions", "[lookup_cache]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/lookup_cache/commit_lookup()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	std::vector<git_oid> commits;
+	for(auto i = 0; i < 10; ++i)
+		commits.emplace_back(commit_files(repo, {{"file", std::to_string(i)}}, commits.empty() ? std::vector<git_oid>{} : std::vector<git_oid>{commits.back()},
+		                                  1000000000 + i));
+
+	git2pp::lookup_cache cache(repo);
+	const auto first = cache.commit_lookup(commits[0]);
+	REQUIRE(first);
+	CHECK(cache.commit_lookup(commits[0]) == first);
+	CHECK(!cache.tree_lookup(commits[0]));
+	CHECK(cache.tree_lookup(first->tree_id()));
+	CHECK(cache.tree_lookup(first->tree_id()));
+
+	auto stats = cache.stats();
+	CHECK(stats.hits == 2);
+	CHECK(stats.misses == 3);
+	CHECK(stats.evictions == 0);
+	CHECK(stats.entries == 2);
+
+	cache.clear();
+	cache.budget(stats.bytes);
+	cache.reset_stats();
+	for(auto && id : commits)
+		CHECK(cache.commit_lookup(id));
+	stats = cache.stats();
+	CHECK(stats.misses == commits.size());
+	CHECK(stats.evictions > 0);
+	CHECK(stats.bytes <= cache.budget());
+	CHECK(!git_oid_cmp(&first->id(), &commits[0]));
+}
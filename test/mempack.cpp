@@ -0,0 +1,118 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/mempack.hpp"
+#include "libgit2++/repository.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+#include <cstdio>
+#include <string>
+
+
+TEST_CASE("flush() - objects are packed", "[mempack]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/mempack/flush()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	git2pp::mempack pack(repo);
+	CHECK(pack.valid());
+	CHECK(pack.flush() == 0);
+
+	const auto first  = repo.blob_create_from_buffer("first");
+	const auto second = repo.blob_create_from_buffer("second");
+	CHECK(repo.object_database().exists(first));
+	CHECK(repo.object_database().exists(second));
+
+	CHECK(pack.flush() == 2);
+	CHECK(pack.flush() == 0);
+
+	auto reopened = git2pp::repository::open(dir);
+	CHECK(reopened.object_database().exists(first));
+	CHECK(reopened.object_database().exists(second));
+}
+
+TEST_CASE("flush() - streamed blobs are packed", "[mempack]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/mempack/flush()/2";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	git2pp::mempack pack(repo);
+
+	auto writer = repo.blob_create_from_stream("streamed.txt");
+	REQUIRE(writer.write("streamed "));
+	REQUIRE(writer.write("content"));
+	const auto streamed = writer.commit();
+	REQUIRE(streamed);
+	CHECK(repo.blob_lookup(*streamed).content() == "streamed content");
+	CHECK(pack.pending() == 1);
+
+	CHECK(pack.flush() == 1);
+	CHECK(pack.pending() == 0);
+
+	auto reopened = git2pp::repository::open(dir);
+	CHECK(reopened.object_database().exists(*streamed));
+}
+
+TEST_CASE("~mempack() - later writes reach the object directory", "[mempack]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/mempack/~mempack()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	git_oid captured;
+	{
+		git2pp::mempack pack(repo);
+		captured = repo.blob_create_from_buffer("captured");
+	}
+	const auto written = repo.blob_create_from_buffer("written");
+
+	auto writer = repo.blob_create_from_stream();
+	REQUIRE(writer.write("streamed"));
+	const auto streamed = writer.commit();
+	REQUIRE(streamed);
+
+	auto reopened = git2pp::repository::open(dir);
+	CHECK(reopened.object_database().exists(captured));
+	CHECK(reopened.object_database().exists(written));
+	CHECK(reopened.object_database().exists(*streamed));
+}
+
+TEST_CASE("mempack() - nowhere to write after destruction", "[mempack]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/mempack/mempack()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+	repo.object_database();
+
+	// The repository's odb is already open, but the mempack can't open its own
+	const auto objects = dir + "/.git/objects";
+	REQUIRE(!std::rename(objects.c_str(), (objects + "-moved").c_str()));
+	git2pp::mempack pack(repo);
+	REQUIRE(!std::rename((objects + "-moved").c_str(), objects.c_str()));
+
+	CHECK_FALSE(pack.valid());
+	const auto written = repo.blob_create_from_buffer("written");
+	CHECK(pack.pending() == 0);
+	CHECK(pack.flush() == 0);
+
+	auto reopened = git2pp::repository::open(dir);
+	CHECK(reopened.object_database().exists(written));
+}
@@ -0,0 +1,130 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/odb.hpp"
+#include "libgit2++/oid.hpp"
+#include "libgit2++/repository.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+#include <cstring>
+#include <git2/odb.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+TEST_CASE("read_header() - read_headers()", "[odb]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/odb/read_header()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const auto blob   = repo.blob_create_from_buffer("some content");
+	const auto commit = commit_files(repo, {{"file", "some content"}}, {}, 1500000000);
+	const auto tree   = repo.commit_lookup(commit).tree_id();
+	git_oid missing;
+	git_odb_hash(&missing, "never written", 13, GIT_OBJ_BLOB);
+
+	const auto db     = repo.object_database();
+	const auto header = db.read_header(blob);
+	REQUIRE(header);
+	CHECK(header->type == git2pp::object_type::blob);
+	CHECK(header->size == 12);
+	CHECK_FALSE(db.read_header(missing));
+
+	const auto headers = db.read_headers({commit, missing, tree, blob});
+	REQUIRE(headers.size() == 4);
+	REQUIRE(headers[0]);
+	CHECK(headers[0]->type == git2pp::object_type::commit);
+	CHECK(headers[0]->size == db.read(commit).size());
+	CHECK_FALSE(headers[1]);
+	REQUIRE(headers[2]);
+	CHECK(headers[2]->type == git2pp::object_type::tree);
+	REQUIRE(headers[3]);
+	CHECK(headers[3]->size == 12);
+}
+
+TEST_CASE("exists_many()", "[odb]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/odb/exists_many()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const auto first  = repo.blob_create_from_buffer("first");
+	const auto second = repo.blob_create_from_buffer("second");
+	git_oid missing;
+	git_odb_hash(&missing, "never written", 13, GIT_OBJ_BLOB);
+
+	auto db = repo.object_database();
+	CHECK(db.exists(first));
+	CHECK_FALSE(db.exists(missing));
+	CHECK(db.exists_many({missing, first, missing, second}) == (std::vector<bool>{false, true, false, true}));
+	CHECK(db.exists_many({}).empty());
+
+	db.refresh();
+	CHECK(db.exists_many({second}) == std::vector<bool>{true});
+}
+
+TEST_CASE("exists_prefix() - read_prefix()", "[odb]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/odb/exists_prefix()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	// Two blobs whose IDs share the shortest prefix libgit2 takes
+	std::vector<std::pair<std::string, git_oid>> hashed;
+	std::string first, second;
+	for(auto i = 0; first.empty(); ++i) {
+		const auto content = "blob " + std::to_string(i);
+		git_oid id;
+		git_odb_hash(&id, content.data(), content.size(), GIT_OBJ_BLOB);
+		for(auto && other : hashed)
+			if(!git_oid_ncmp(&id, &other.second, GIT_OID_MINPREFIXLEN)) {
+				first  = other.first;
+				second = content;
+				break;
+			}
+		hashed.emplace_back(content, id);
+	}
+	const auto first_id  = repo.blob_create_from_buffer(first);
+	const auto second_id = repo.blob_create_from_buffer(second);
+	const auto unique    = repo.blob_create_from_buffer("unique");
+
+	const auto db = repo.object_database();
+	CHECK_FALSE(db.exists_prefix(first_id, GIT_OID_MINPREFIXLEN));
+	CHECK_FALSE(db.exists_prefix(unique, GIT_OID_MINPREFIXLEN - 1));
+
+	auto shared = GIT_OID_MINPREFIXLEN;
+	while(!git_oid_ncmp(&first_id, &second_id, shared + 1))
+		++shared;
+	const auto resolved = db.exists_prefix(second_id, shared + 1);
+	REQUIRE(resolved);
+	CHECK(git2pp::oid(*resolved) == second_id);
+
+	const auto unique_resolved = db.exists_prefix(unique, 7);
+	REQUIRE(unique_resolved);
+	CHECK(git2pp::oid(*unique_resolved) == unique);
+
+	const auto obj = db.read_prefix(unique, 7);
+	CHECK(git2pp::oid(obj.id()) == unique);
+	CHECK(obj.type() == git2pp::object_type::blob);
+	REQUIRE(obj.size() == 6);
+	CHECK(!std::memcmp(obj.data(), "unique", 6));
+}
@@ -0,0 +1,78 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/oid.hpp"
+#include "catch.hpp"
+#include <string>
+#include <unordered_set>
+
+
+using namespace git2pp::literals;
+
+
+TEST_CASE("from_hex() - round-trip", "[oid]") {
+	const std::string hex = "0123456789abcdef0123456789abcdeffedcba98";
+	const auto id         = git2pp::oid::from_hex(hex);
+	REQUIRE(id);
+	CHECK(id->str() == hex);
+	CHECK(*id == "0123456789abcdef0123456789abcdeffedcba98"_oid);
+	CHECK(*git2pp::oid::from_hex("0123456789ABCDEF0123456789ABCDEFFEDCBA98") == *id);
+
+	char buf[git2pp::oid::hex_size + 1];
+	id->to_hex(buf);
+	CHECK(buf == hex);
+}
+
+TEST_CASE("from_hex() - invalid", "[oid]") {
+	CHECK_FALSE(git2pp::oid::from_hex("0123456789abcdef0123456789abcdeffedcba9"));
+	CHECK_FALSE(git2pp::oid::from_hex("0123456789abcdef0123456789abcdeffedcba988"));
+	CHECK_FALSE(git2pp::oid::from_hex("0123456789abcdeg0123456789abcdeffedcba98"));
+	CHECK_FALSE(git2pp::oid::from_hex("0123456789abcdef0123456789abcdeffedcba9g"));
+	CHECK_FALSE(git2pp::oid::from_hex("0123456789abcdef012345:789abcdeffedcba98"));
+	CHECK_THROWS_AS("0123456789abcdef"_oid, std::invalid_argument);
+}
+
+TEST_CASE("literal - constexpr", "[oid]") {
+	constexpr auto id = "ffffffffffffffffffffffffffffffffffffffff"_oid;
+	CHECK(id.str() == std::string(40, 'f'));
+	CHECK(git2pp::oid{}.zero());
+	CHECK_FALSE(id.zero());
+}
+
+TEST_CASE("ordering", "[oid]") {
+	const auto low  = "0000000000000000000000000000000000000001"_oid;
+	const auto high = "1000000000000000000000000000000000000000"_oid;
+	CHECK(low < high);
+	CHECK(low <= high);
+	CHECK(high > low);
+	CHECK(high >= low);
+	CHECK(low != high);
+	CHECK(low.compare(high) < 0);
+	CHECK(!git_oid_cmp(&static_cast<const git_oid &>(low), &static_cast<const git_oid &>(git2pp::oid(low))));
+}
+
+TEST_CASE("std::hash", "[oid]") {
+	std::unordered_set<git2pp::oid> ids{"0000000000000000000000000000000000000001"_oid, "1000000000000000000000000000000000000000"_oid};
+	CHECK(ids.count("0000000000000000000000000000000000000001"_oid));
+	CHECK_FALSE(ids.count(git2pp::oid{}));
+}
@@ -0,0 +1,100 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/oid_map.hpp"
+#include "libgit2++/oid_set.hpp"
+#include "catch.hpp"
+#include <cstring>
+#include <map>
+#include <random>
+
+
+static git2pp::oid random_oid(std::mt19937 & rng) {
+	git_oid id;
+	for(auto && byte : id.id)
+		byte = static_cast<unsigned char>(rng());
+	return id;
+}
+
+
+TEST_CASE("oid_map - matches std::map", "[oid_map]") {
+	std::mt19937 rng(42);
+	std::vector<git2pp::oid> keys;
+	for(auto i = 0; i < 2000; ++i)
+		keys.emplace_back(random_oid(rng));
+
+	git2pp::oid_map<int> map;
+	std::map<git2pp::oid, int> expected;
+	for(auto i = 0; i < 20000; ++i) {
+		const auto & key = keys[rng() % keys.size()];
+		switch(rng() % 3) {
+			case 0:
+				CHECK(map.insert(key, i).second == expected.emplace(key, i).second);
+				break;
+			case 1:
+				map[key] += i;
+				expected[key] += i;
+				break;
+			case 2:
+				CHECK(map.erase(key) == static_cast<bool>(expected.erase(key)));
+				break;
+		}
+	}
+
+	REQUIRE(map.size() == expected.size());
+	for(auto && kv : expected) {
+		REQUIRE(map.find(kv.first));
+		CHECK(*map.find(kv.first) == kv.second);
+	}
+
+	std::size_t iterated{};
+	for(auto && kv : map) {
+		CHECK(expected.at(kv.first) == kv.second);
+		++iterated;
+	}
+	CHECK(iterated == expected.size());
+
+	map.clear();
+	CHECK(map.empty());
+	CHECK_FALSE(map.contains(keys[0]));
+}
+
+TEST_CASE("oid_set", "[oid_set]") {
+	std::mt19937 rng(42);
+	std::vector<git2pp::oid> ids;
+	for(auto i = 0; i < 1000; ++i)
+		ids.emplace_back(random_oid(rng));
+
+	git2pp::oid_set set({ids.begin(), ids.begin() + 500});
+	set.insert_many({ids.begin() + 250, ids.end()});
+	CHECK(set.size() == ids.size());
+	CHECK(std::is_sorted(set.begin(), set.end()));
+	for(auto && id : ids)
+		CHECK(set.contains(id));
+
+	CHECK_FALSE(set.insert(ids[0]));
+	CHECK(set.erase(ids[0]));
+	CHECK_FALSE(set.contains(ids[0]));
+	CHECK(set.insert(ids[0]));
+	CHECK(*set.lower_bound(ids[0]) == ids[0]);
+}
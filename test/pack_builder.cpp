@@ -0,0 +1,51 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/pack_builder.hpp"
+#include "libgit2++/repository.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+#include <string>
+
+
+TEST_CASE("stream() - pack is produced in memory", "[pack_builder]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/pack_builder/stream()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const auto first  = repo.blob_create_from_buffer("first");
+	const auto second = repo.blob_create_from_buffer("second");
+
+	git2pp::pack_builder builder(repo);
+	REQUIRE(builder.insert(first));
+	REQUIRE(builder.insert(second, "second.txt"));
+	CHECK(builder.object_count() == 2);
+
+	std::string pack;
+	REQUIRE(builder.stream([&](const void * data, std::size_t size) {
+		pack.append(static_cast<const char *>(data), size);
+		return true;
+	}));
+	CHECK(pack.compare(0, 4, "PACK") == 0);
+	CHECK(builder.written() == 2);
+}
@@ -0,0 +1,59 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/pack_builder.hpp"
+#include "libgit2++/pack_indexer.hpp"
+#include "libgit2++/repository.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+#include <string>
+
+
+TEST_CASE("append() - pack is indexed in chunks", "[pack_indexer]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/pack_indexer/append()/";
+	remove_directory((dir + "source").c_str());
+	remove_directory((dir + "target").c_str());
+	auto source = git2pp::repository::init(dir + "source");
+	auto target = git2pp::repository::init(dir + "target");
+
+	const auto id = source.blob_create_from_buffer("indexed");
+	git2pp::pack_builder builder(source);
+	REQUIRE(builder.insert(id));
+
+	std::size_t progress_calls{};
+	git2pp::pack_indexer indexer(target, nullptr, 0, [&](auto &&) { ++progress_calls; });
+	REQUIRE(builder.stream([&](const void * data, std::size_t size) {
+		for(std::size_t i = 0; i < size; ++i)
+			if(!indexer.append(static_cast<const char *>(data) + i, 1))
+				return false;
+		return true;
+	}));
+
+	const auto hash = indexer.commit();
+	REQUIRE(hash);
+	const auto built = builder.hash();
+	CHECK(!git_oid_cmp(&*hash, &built));
+	CHECK(indexer.stats().indexed_objects == 1);
+	CHECK(progress_calls > 0);
+	CHECK(target.object_database().exists(id));
+}
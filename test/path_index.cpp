@@ -0,0 +1,156 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/path_index.hpp"
+#include "libgit2++/oid.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+static std::vector<git2pp::oid> as_oids(const std::vector<git_oid> & ids);
+
+
+//   a - b - m
+//    \     /
+//      c -
+// b changes "dir/file", c changes "other", m takes both
+TEST_CASE("path_index", "[path_index]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/path_index/path_index/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const auto a = commit_files(repo, {{"dir/file", "1"}, {"other", "1"}}, {}, 1500000000);
+	const auto b = commit_files(repo, {{"dir/file", "2"}, {"other", "1"}}, {a}, 1500000001);
+	const auto c = commit_files(repo, {{"dir/file", "1"}, {"other", "2"}}, {a}, 1500000002);
+	const auto m = commit_files(repo, {{"dir/file", "2"}, {"other", "2"}}, {b, c}, 1500000003);
+
+	{
+		git2pp::path_index index(repo);
+		CHECK(index.size() == 0);
+		CHECK_FALSE(index.tip());
+
+		REQUIRE(index.update(b));
+		CHECK(index.size() == 2);
+		CHECK(as_oids(index.history("dir/file")) == (std::vector<git2pp::oid>{b, a}));
+		CHECK(as_oids(index.history("dir")) == (std::vector<git2pp::oid>{b, a}));
+		CHECK(as_oids(index.history("other")) == (std::vector<git2pp::oid>{a}));
+		CHECK(index.history("nonexistant").empty());
+		REQUIRE(index.save());
+	}
+
+	git2pp::path_index index(repo);
+	REQUIRE(index.tip());
+	CHECK(git2pp::oid(*index.tip()) == b);
+	CHECK(index.size() == 2);
+
+	REQUIRE(index.update(m));
+	CHECK(index.size() == 4);
+	CHECK(as_oids(index.history("dir/file")) == (std::vector<git2pp::oid>{b, a}));
+	CHECK(as_oids(index.history("other")) == (std::vector<git2pp::oid>{c, a}));
+	CHECK(git2pp::oid(*index.last_commit("dir")) == b);
+	CHECK_FALSE(index.last_commit("nonexistant"));
+
+	const auto root = repo.commit_lookup(m).tree();
+	const auto last = index.last_modified(root, "");
+	REQUIRE(last.size() == 2);
+	CHECK(git2pp::oid(*last[0]) == b);
+	CHECK(git2pp::oid(*last[1]) == c);
+
+	const auto in_dir = index.last_modified(repo.tree_lookup(root.at_path("dir").id()), "dir");
+	REQUIRE(in_dir.size() == 1);
+	CHECK(git2pp::oid(*in_dir[0]) == b);
+
+	// c doesn't descend from m, so the index starts over
+	REQUIRE(index.update(c));
+	CHECK(index.size() == 2);
+	CHECK(as_oids(index.history("dir/file")) == (std::vector<git2pp::oid>{a}));
+	CHECK(as_oids(index.history("other")) == (std::vector<git2pp::oid>{c, a}));
+}
+
+//   a - b - mb, mc
+//    \     /
+//      c -
+// b and c both change "file", mb keeps b's and mc keeps c's
+TEST_CASE("path_index merge keeping one side", "[path_index]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/path_index/one_side/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const auto a  = commit_files(repo, {{"file", "1"}, {"other", "1"}}, {}, 1500000000);
+	const auto b  = commit_files(repo, {{"file", "2"}, {"other", "1"}}, {a}, 1500000001);
+	const auto c  = commit_files(repo, {{"file", "3"}, {"other", "1"}}, {a}, 1500000002);
+	const auto mb = commit_files(repo, {{"file", "2"}, {"other", "1"}}, {b, c}, 1500000003);
+	const auto mc = commit_files(repo, {{"file", "3"}, {"other", "1"}}, {b, c}, 1500000004);
+	const auto d  = commit_files(repo, {{"file", "2"}, {"other", "2"}}, {mb}, 1500000005);
+
+	for(auto && tip : {std::make_pair(mb, b), std::make_pair(mc, c), std::make_pair(d, b)}) {
+		git2pp::path_index index(repo, dir + "/.git/path-index-" + git2pp::oid(tip.first).str());
+		REQUIRE(index.update(tip.first));
+		REQUIRE(index.save());
+
+		git2pp::path_index reloaded(repo, dir + "/.git/path-index-" + git2pp::oid(tip.first).str());
+		for(auto idx : {&index, &reloaded}) {
+			const auto history = as_oids(idx->history("file"));
+			CHECK(std::find(history.begin(), history.end(), git2pp::oid(b)) != history.end());
+			CHECK(std::find(history.begin(), history.end(), git2pp::oid(c)) != history.end());
+			CHECK(git2pp::oid(*idx->last_commit("file")) == tip.second);
+
+			const auto last = idx->last_modified(repo.commit_lookup(tip.first).tree(), "");
+			REQUIRE(last.size() == 2);
+			CHECK(git2pp::oid(*last[0]) == tip.second);
+		}
+	}
+}
+
+TEST_CASE("path_index damaged", "[path_index]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/path_index/damaged/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const auto a = commit_files(repo, {{"file", "1"}}, {}, 1500000000);
+	{
+		git2pp::path_index index(repo);
+		REQUIRE(index.update(a));
+		REQUIRE(index.save());
+	}
+	{
+		std::fstream file(dir + "/.git/path-index", std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(20);
+		file.put('\xFF');
+	}
+
+	git2pp::path_index index(repo);
+	CHECK(index.size() == 0);
+	CHECK_FALSE(index.tip());
+	REQUIRE(index.update(a));
+	CHECK(as_oids(index.history("file")) == (std::vector<git2pp::oid>{a}));
+}
+
+
+static std::vector<git2pp::oid> as_oids(const std::vector<git_oid> & ids) {
+	return {ids.begin(), ids.end()};
+}
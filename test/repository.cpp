@@ -22,10 +22,12 @@
 
 
 #include "libgit2++/repository.hpp"
+#include "libgit2++/oid.hpp"
 #include "catch.hpp"
 #include "util.hpp"
 #include <fstream>
 #include <string>
+#include <vector>
 
 
 void check_for_head(std::string head);
@@ -47,6 +49,79 @@ TEST_CASE("init() - bare", "[repository]") {
 	check_for_head(dir + "/HEAD");
 }
 
+TEST_CASE("blob_create_from_stream()", "[repository]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/repository/blob_create_from_stream()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	auto writer = repo.blob_create_from_stream();
+	std::string content;
+	for(auto i = 0; i < 1000; ++i) {
+		const auto line = "line " + std::to_string(i) + '\n';
+		REQUIRE(writer.write(line));
+		content += line;
+	}
+
+	const auto id = writer.commit();
+	REQUIRE(id);
+	const auto expected = repo.blob_create_from_buffer(content);
+	CHECK(!git_oid_cmp(&*id, &expected));
+	CHECK_FALSE(writer.write(content));
+	CHECK_FALSE(writer.commit());
+}
+
+TEST_CASE("hash_files()", "[repository]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/repository/hash_files()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	std::vector<std::string> paths;
+	for(auto i = 0; i < 200; ++i) {
+		paths.emplace_back(dir + "/file" + std::to_string(i) + ".txt");
+		std::ofstream(paths.back()) << "file " << i << '\n';
+	}
+	paths.emplace_back(dir + "/nonexistant");
+
+	const auto ids = repo.hash_files(paths, git2pp::object_type::blob, nullptr, 4);
+	REQUIRE(ids.size() == paths.size());
+	for(auto i = 0u; i < paths.size() - 1; ++i) {
+		const auto expected = repo.hash_file(paths[i], git2pp::object_type::blob);
+		CHECK(!git_oid_cmp(&ids[i], &expected));
+	}
+	CHECK(git_oid_iszero(&ids.back()));
+}
+
+
+//   a - b - c
+//   |
+//   d          lone
+TEST_CASE("merge_base() - ahead_behind()", "[repository]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/repository/merge_base()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const auto a    = commit_files(repo, {{"file", "a"}}, {}, 1500000000);
+	const auto b    = commit_files(repo, {{"file", "b"}}, {a}, 1500000001);
+	const auto c    = commit_files(repo, {{"file", "c"}}, {b}, 1500000002, "refs/heads/master");
+	const auto d    = commit_files(repo, {{"file", "d"}}, {a}, 1500000003, "refs/heads/topic");
+	const auto lone = commit_files(repo, {{"file", "lone"}}, {}, 1500000004, "refs/heads/lone");
+
+	const auto base = repo.merge_base(c, d);
+	REQUIRE(base);
+	CHECK(git2pp::oid(*base) == a);
+	CHECK_FALSE(repo.merge_base(c, lone));
+	CHECK(repo.merge_bases(c, d).size() == 1);
+	CHECK(repo.merge_bases(c, lone).empty());
+	// Between c and a merge of d and b, so b
+	CHECK(git2pp::oid(repo.merge_base_many({c, d, b}).value_or(git_oid{})) == b);
+	CHECK(git2pp::oid(repo.merge_base_octopus({c, b}).value_or(git_oid{})) == b);
+
+	CHECK(repo.ahead_behind(d, c) == std::make_pair(std::size_t{1}, std::size_t{2}));
+	CHECK(repo.ahead_behind(c, c) == std::make_pair(std::size_t{0}, std::size_t{0}));
+	CHECK(repo.descendant_of(c, a));
+	CHECK_FALSE(repo.descendant_of(a, c));
+	CHECK_FALSE(repo.descendant_of(c, c));
+}
 
 void check_for_head(std::string head_path) {
 	INFO(head_path);
@@ -0,0 +1,162 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/repository_pool.hpp"
+#include "libgit2++/oid.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE("acquire() - handles are reused", "[repository_pool]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/repository_pool/acquire()/1";
+	remove_directory(dir.c_str());
+	git2pp::repository::init(dir);
+
+	git2pp::repository_pool pool(dir, 2);
+	CHECK(pool.valid());
+	CHECK(pool.capacity() == 2);
+	CHECK(pool.size() == 1);
+
+	{
+		auto first  = pool.acquire();
+		auto second = pool.acquire();
+		CHECK(pool.size() == 2);
+		CHECK(first->path() == second->path());
+	}
+
+	std::vector<std::thread> threads;
+	for(auto i = 0; i < 8; ++i)
+		threads.emplace_back([&]() {
+			for(auto j = 0; j < 100; ++j)
+				pool.acquire()->empty();
+		});
+	for(auto && thread : threads)
+		thread.join();
+	CHECK(pool.size() == 2);
+}
+
+TEST_CASE("acquire() - nonexistent repository", "[repository_pool]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/repository_pool/acquire()/2";
+	remove_directory(dir.c_str());
+
+	git2pp::repository_pool pool(dir, 1);
+	CHECK_FALSE(pool.valid());
+	CHECK(pool.size() == 0);
+
+	// Would block on the second one if the first counted against capacity()
+	pool.acquire();
+	pool.acquire();
+	CHECK(pool.size() == 0);
+}
+
+TEST_CASE("lookup_many() - results in input order", "[repository_pool]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/repository_pool/lookup_many()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	std::vector<git_oid> commits;
+	for(auto i = 0; i < 150; ++i)
+		commits.emplace_back(commit_files(repo, {{"file", std::to_string(i)}}, commits.empty() ? std::vector<git_oid>{} : std::vector<git_oid>{commits.back()},
+		                                  1500000000 + i));
+	std::reverse(commits.begin(), commits.end());
+
+	// Each one four times over, enough for 9 slices of at least 64 to queue on the pool's 3 handles
+	std::vector<git_oid> ids;
+	for(auto i = 0; i < 4; ++i)
+		ids.insert(ids.end(), commits.begin(), commits.end());
+
+	// Never written, so it's missing in the middle of a slice
+	git_oid missing;
+	std::fill(std::begin(missing.id), std::end(missing.id), 0x5A);
+	const auto missing_idx = ids.size() / 3;
+	ids.insert(ids.begin() + missing_idx, missing);
+
+	git2pp::repository_pool pool(dir, 3);
+	for(auto threads : {0u, 1u, 2u, 3u, 9u, 64u}) {
+		INFO(threads);
+
+		const auto found = pool.commit_lookup_many(ids, threads);
+		REQUIRE(found.size() == ids.size());
+		for(std::size_t i = 0; i < ids.size(); ++i)
+			if(i == missing_idx)
+				CHECK_FALSE(found[i].valid());
+			else {
+				REQUIRE(found[i].valid());
+				CHECK(git2pp::oid(found[i].id()) == ids[i]);
+			}
+
+		const auto objects = pool.lookup_many(ids, git2pp::object_type::commit, threads);
+		REQUIRE(objects.size() == ids.size());
+		for(std::size_t i = 0; i < ids.size(); ++i)
+			if(i == missing_idx)
+				CHECK_FALSE(objects[i].valid());
+			else {
+				REQUIRE(objects[i].valid());
+				CHECK(git2pp::oid(objects[i].id()) == ids[i]);
+			}
+	}
+	CHECK(pool.size() <= 3);
+
+	std::vector<git_oid> trees;
+	for(auto && id : commits)
+		trees.emplace_back(repo.commit_lookup(id).tree_id());
+	const auto found_trees = pool.tree_lookup_many(trees, 2);
+	REQUIRE(found_trees.size() == trees.size());
+	for(std::size_t i = 0; i < trees.size(); ++i) {
+		REQUIRE(found_trees[i].valid());
+		CHECK(git2pp::oid(found_trees[i].id()) == trees[i]);
+	}
+}
+
+TEST_CASE("blob_lookup_many() - results in input order", "[repository_pool]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/repository_pool/blob_lookup_many()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	std::vector<git_oid> ids;
+	for(auto i = 0; i < 200; ++i)
+		ids.emplace_back(repo.blob_create_from_buffer(std::to_string(i)));
+	// A commit isn't a blob
+	const auto commit = commit_files(repo, {{"file", "1"}}, {}, 1500000000);
+	ids.insert(ids.begin() + 100, commit);
+
+	git2pp::repository_pool pool(dir, 2);
+	for(auto threads : {1u, 3u}) {
+		INFO(threads);
+
+		const auto blobs = pool.blob_lookup_many(ids, threads);
+		REQUIRE(blobs.size() == ids.size());
+		for(std::size_t i = 0; i < ids.size(); ++i)
+			if(i == 100)
+				CHECK_FALSE(blobs[i].valid());
+			else {
+				REQUIRE(blobs[i].valid());
+				CHECK(blobs[i].content() == std::to_string(i < 100 ? i : i - 1));
+			}
+	}
+}
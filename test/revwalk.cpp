@@ -0,0 +1,76 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/revwalk.hpp"
+#include "libgit2++/oid.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+#include <vector>
+
+
+//   a - b - c - m
+//    \         /
+//     d ----- e
+TEST_CASE("revwalk - sorting, hiding and first parent", "[revwalk]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/revwalk/revwalk/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	const auto a = commit_files(repo, {{"file", "a"}}, {}, 1000);
+	const auto b = commit_files(repo, {{"file", "b"}}, {a}, 1001);
+	const auto d = commit_files(repo, {{"file", "d"}}, {a}, 1002);
+	const auto c = commit_files(repo, {{"file", "c"}}, {b}, 1003);
+	const auto e = commit_files(repo, {{"file", "e"}}, {d}, 1004);
+	const auto m = commit_files(repo, {{"file", "m"}}, {c, e}, 1005, "refs/heads/master");
+
+	git2pp::revwalk walk(repo);
+	walk.sorting(git2pp::revwalk_sort::time);
+	REQUIRE(walk.push_head());
+	std::vector<git2pp::oid> walked(walk.begin(), walk.end());
+	CHECK(walked == (std::vector<git2pp::oid>{m, e, c, d, b, a}));
+
+	walk.sorting(git2pp::revwalk_sort::topological | git2pp::revwalk_sort::reverse);
+	REQUIRE(walk.push(m));
+	REQUIRE(walk.hide(b));
+	walked.assign(walk.begin(), walk.end());
+	REQUIRE(walked.size() == 4);
+	CHECK(walked.back() == m);
+	CHECK(walked.front() != git2pp::oid(a));
+
+	walk.sorting(git2pp::revwalk_sort::time);
+	walk.simplify_first_parent();
+	REQUIRE(walk.push_ref("refs/heads/master"));
+	walked.assign(walk.begin(), walk.end());
+	CHECK(walked == (std::vector<git2pp::oid>{m, c, b, a}));
+
+	walk.reset();
+	REQUIRE(walk.push_range(git2pp::oid(a).str() + ".." + git2pp::oid(m).str()));
+	std::size_t seen{};
+	for(auto && id : walk) {
+		static_cast<void>(id);
+		if(++seen == 2)
+			break;
+	}
+	CHECK(seen == 2);
+	CHECK(walk.next());
+}
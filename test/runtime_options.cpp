@@ -0,0 +1,61 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/runtime_options.hpp"
+#include "libgit2++/repository.hpp"
+#include "catch.hpp"
+#include "util.hpp"
+
+
+TEST_CASE("mwindow_size()", "[runtime_options]") {
+	git2pp::runtime_options opts;
+	const auto original = opts.mwindow_size();
+
+	opts.mwindow_size(1024 * 1024);
+	CHECK(opts.mwindow_size() == 1024 * 1024);
+	opts.mwindow_size(original);
+	CHECK(opts.mwindow_size() == original);
+}
+
+TEST_CASE("cache_max_size() - cached_memory()", "[runtime_options]") {
+	const auto dir = git2pp::discover_repository(".") + "../out/test/repos/runtime_options/cache_max_size()/1";
+	remove_directory(dir.c_str());
+	auto repo = git2pp::repository::init(dir);
+
+	git2pp::runtime_options opts;
+	const auto original = opts.cache_max_size();
+
+	opts.caching(true);
+	opts.cache_max_size(64 * 1024 * 1024);
+	CHECK(opts.cache_max_size() == 64 * 1024 * 1024);
+	CHECK(opts.cached_memory().allowed == 64 * 1024 * 1024);
+
+	// Looked-up commits go in the cache
+	const auto commit = repo.commit_lookup(commit_files(repo, {{"file", "content"}}, {}, 1500000000));
+	const auto usage  = opts.cached_memory();
+	CHECK(usage.current > 0);
+	CHECK(usage.current <= usage.allowed);
+
+	opts.cache_max_size(original);
+	CHECK(opts.cache_max_size() == original);
+}
@@ -0,0 +1,99 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "libgit2++/signature_pool.hpp"
+#include "catch.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+TEST_CASE("signature_pool - intern()", "[signature_pool]") {
+	git2pp::signature_pool pool;
+
+	const auto ann = pool.intern("Ann", "ann@example.com");
+	const auto bob = pool.intern("Bob", "bob@example.com");
+	CHECK(ann != bob);
+	CHECK(pool.intern("Ann", "ann@example.com") == ann);
+	CHECK(pool.intern("Ann", "ann@example.org") != ann);
+	CHECK(pool.intern_raw("Bob <bob@example.com> 1500000000 +0200") == bob);
+	CHECK(pool.size() == 3);
+
+	const auto name = pool.name(ann);
+	CHECK(name == "Ann");
+	CHECK(pool.email(ann) == "ann@example.com");
+
+	char sig_name[]  = "Bob";
+	char sig_email[] = "bob@example.com";
+	CHECK(pool.intern(git_signature{sig_name, sig_email, {}}) == bob);
+
+	const auto sig = pool.to_signature(bob, {1500000000, 120});
+	CHECK(std::strcmp(sig.name, "Bob") == 0);
+	CHECK(std::strcmp(sig.email, "bob@example.com") == 0);
+	CHECK(sig.when.offset == 120);
+
+	CHECK(*pool.find("Bob", "bob@example.com") == bob);
+	CHECK_FALSE(pool.find("Bob", "bob@example.org"));
+
+	// Enough to rehash and spill into more blocks; earlier views stay put
+	for(auto i = 0; i < 10000; ++i)
+		pool.intern("Person " + std::to_string(i), std::string(i % 7 ? 10 : 20000, 'x') + std::to_string(i) + "@example.com");
+	CHECK(pool.size() == 10003);
+	CHECK(name.data() == pool.name(ann).data());
+	CHECK(pool.intern("Person 43", std::string(10, 'x') + "43@example.com") == 46);
+	CHECK(pool.intern("Person 42", std::string(20000, 'x') + "42@example.com") == 45);
+
+	pool.clear();
+	CHECK(pool.size() == 0);
+	CHECK(pool.arena_size() == 0);
+	CHECK_FALSE(pool.find("Ann", "ann@example.com"));
+}
+
+TEST_CASE("signature_pool - intern_raw() - malformed", "[signature_pool]") {
+	git2pp::signature_pool pool;
+
+	const auto spaced = pool.intern_raw("Name  Spaces  <a@b> 1 +0000");
+	CHECK(pool.name(spaced) == "Name  Spaces");
+	CHECK(pool.email(spaced) == "a@b");
+
+	const auto no_email = pool.intern_raw("Nobody");
+	CHECK(pool.name(no_email) == "Nobody");
+	CHECK(pool.email(no_email).empty());
+
+	const auto brackets = pool.intern_raw("A > B <c> 1 +0000");
+	CHECK(pool.name(brackets) == "A > B");
+	CHECK(pool.email(brackets) == "c");
+}
+
+TEST_CASE("signature_pool - merge()", "[signature_pool]") {
+	git2pp::signature_pool one;
+	git2pp::signature_pool two;
+	one.intern("A", "a");
+	one.intern("B", "b");
+	two.intern("C", "c");
+	two.intern("A", "a");
+
+	CHECK(one.merge(two) == (std::vector<git2pp::signature_pool::handle>{2, 0}));
+	CHECK(one.size() == 3);
+	CHECK(one.name(2) == "C");
+}
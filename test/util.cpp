@@ -0,0 +1,69 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "util.hpp"
+
+
+static git_oid write_tree(git2pp::repository & repo, std::map<std::string, std::string>::const_iterator begin,
+                          std::map<std::string, std::string>::const_iterator end, std::size_t prefix_len);
+
+
+git_oid commit_files(git2pp::repository & repo, const std::map<std::string, std::string> & files, const std::vector<git_oid> & parents, git_time_t time,
+                     const char * update_ref) {
+	const auto tree = repo.tree_lookup(write_tree(repo, files.begin(), files.end(), 0));
+
+	std::vector<git2pp::commit> parent_commits;
+	for(auto && parent : parents)
+		parent_commits.emplace_back(repo.commit_lookup(parent));
+	std::vector<const git2pp::commit *> parent_ptrs;
+	for(auto && parent : parent_commits)
+		parent_ptrs.emplace_back(&parent);
+
+	char name[]  = "Test";
+	char email[] = "test@test.localhost";
+	const git_signature sig{name, email, {time, 0}};
+	return repo.commit_create(sig, sig, "Commit at " + std::to_string(time) + '\n', tree, parent_ptrs, update_ref);
+}
+
+
+// [begin, end) is a sorted run sharing the first prefix_len characters, which are a directory path with trailing slash
+static git_oid write_tree(git2pp::repository & repo, std::map<std::string, std::string>::const_iterator begin,
+                          std::map<std::string, std::string>::const_iterator end, std::size_t prefix_len) {
+	git2pp::commit_tree_builder bld(repo);
+	while(begin != end) {
+		const auto & path = begin->first;
+		const auto slash  = path.find('/', prefix_len);
+		if(slash == std::string::npos) {
+			bld.insert(path.substr(prefix_len), repo.blob_create_from_buffer(begin->second), git2pp::filemode::blob);
+			++begin;
+		} else {
+			const auto dir = path.substr(0, slash + 1);
+			auto dir_end   = begin;
+			while(dir_end != end && dir_end->first.compare(0, dir.size(), dir) == 0)
+				++dir_end;
+			bld.insert(dir.substr(prefix_len, dir.size() - prefix_len - 1), write_tree(repo, begin, dir_end, dir.size()), git2pp::filemode::tree);
+			begin = dir_end;
+		}
+	}
+	return bld.write();
+}
@@ -24,4 +24,14 @@
 #pragma once
 
 
+#include "libgit2++/repository.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+
 void remove_directory(const char * path);
+
+// files maps slash-separated paths to their contents; time is the author and committer time in seconds since the epoch
+git_oid commit_files(git2pp::repository & repo, const std::map<std::string, std::string> & files, const std::vector<git_oid> & parents, git_time_t time,
+                     const char * update_ref = nullptr);